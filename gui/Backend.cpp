@@ -1,26 +1,47 @@
 #include "Backend.hpp"
+#include "../shared/Decimation.hpp"
 #include "../shared/Sampling.hpp"
-#include "../shared/fir/BlackmanWindow.hpp"
 #include "../shared/fir/FIRFilter.hpp"
-#include "../shared/fir/RectangularWindow.hpp"
-#include "../shared/iir/IIRFilter.hpp"
-#include "../shared/iir/LowPassRCCircuit.hpp"
-#include "../shared/iir/HighPassCRCircuit.hpp"
+#include "../shared/fir/RemezFilter.hpp"
+#include "../shared/iir/SOSFilter.hpp"
 #include "ListSelectorValues.hpp"
 #include <QAreaSeries>
 #include <QDebug>
 #include <QQuickItem>
 #include <QQuickView>
 #include <QRandomGenerator>
+#include <QChart>
 #include <QXYSeries>
 #include <QtMath>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 
 Backend::Backend(QObject *parent) : QObject{parent} {
+  qRegisterMetaType<FilterParameters>();
+  qRegisterMetaType<FilterCalculation>();
+
+  calculator = new FilterCalculator(latestGeneration);
+  calculator->moveToThread(&calculatorThread);
+  QObject::connect(&calculatorThread, &QThread::finished, calculator,
+                   &QObject::deleteLater);
+  QObject::connect(calculator, &FilterCalculator::calculated, this,
+                   &Backend::applyCalculation);
+  QObject::connect(calculator, &FilterCalculator::filterSizeRefined, this,
+                   &Backend::applyFilterSizeRefinement);
+  calculatorThread.start();
+
   QObject::connect(this, &Backend::recalculationNeeded,
                    &Backend::recalculateCoefficientsAndFrequencyResponse);
 }
 
+Backend::~Backend() {
+  // abandon in-flight calculation
+  latestGeneration++;
+  calculatorThread.quit();
+  calculatorThread.wait();
+}
+
 int Backend::getSamplingRate() const { return samplingRate; }
 int Backend::getSamplingRateRangeFrom() const {
   return defaultSamplingRateRange.from;
@@ -36,6 +57,7 @@ void Backend::setSamplingRate(int value) {
                           getSamplingRateRangeFrom());
 
   setVisibleFrequencyTo(nyquistFrequency(samplingRate));
+  updateFilterSize();
 
   emit controlsStateChanged();
   emit recalculationNeeded();
@@ -60,6 +82,7 @@ void Backend::setCutoffFrequency(int value) {
     setVisibleFrequencyTo(cutoffFrequency *
                           displayedFrequencyResponseCutoffMult);
   }
+  updateFilterSize();
 
   emit controlsStateChanged();
   emit recalculationNeeded();
@@ -81,6 +104,7 @@ void Backend::setPassType(QString value) {
     return;
   }
   passType = toPassType(value.toStdString());
+  updateFilterSize();
 
   emit controlsStateChanged();
   emit recalculationNeeded();
@@ -104,6 +128,8 @@ void Backend::setFilterType(QString value) {
   }
   filterType = toFilterType(value.toStdString());
 
+  updateFilterSize();
+
   emit controlsStateChanged();
   emit recalculationNeeded();
 }
@@ -126,6 +152,8 @@ void Backend::setWindowType(QString value) {
   }
   windowType = toWindowType(value.toStdString());
 
+  updateFilterSize();
+
   emit controlsStateChanged();
   emit recalculationNeeded();
 }
@@ -144,15 +172,10 @@ void Backend::setAttenuationDB(int value) {
   attenuationDB = std::max(std::min(value, getAttenuationDBRangeTo()),
                            getAttenuationDBRangeFrom());
 
-  if (useOptimalFilterSize) {
-    setFilterSize(FIRFilter::getOptimalCoefficientsCount(
-        samplingRate, attenuationDB, transitionLength));
-  } else {
-    setTransitionLength(FIRFilter::getTransitionLength(
-        samplingRate, attenuationDB, filterSize));
-  }
+  updateFilterSize();
 
   emit controlsStateChanged();
+  emit recalculationNeeded();
 }
 
 int Backend::getTransitionLength() const { return transitionLength; }
@@ -170,18 +193,19 @@ void Backend::setTransitionLength(int value) {
                               getTransitionLengthRangeFrom());
 
   if (useOptimalFilterSize) {
-    setFilterSize(FIRFilter::getOptimalCoefficientsCount(
-        samplingRate, attenuationDB, transitionLength));
+    setFilterSize(getOptimalFilterSize());
   }
 
   emit controlsStateChanged();
+  // equiripple filters are designed for the transition band
+  emit recalculationNeeded();
 }
 
 int Backend::getFilterSize() const { return filterSize; }
 int Backend::getFilterSizeRangeFrom() const {
-  return defaultFilterSizeRange.from;
+  return getFilterSizeRange().from;
 }
-int Backend::getFilterSizeRangeTo() const { return defaultFilterSizeRange.to; }
+int Backend::getFilterSizeRangeTo() const { return getFilterSizeRange().to; }
 void Backend::setFilterSize(int value) {
   if (value == filterSize) {
     return;
@@ -190,8 +214,7 @@ void Backend::setFilterSize(int value) {
                         getFilterSizeRangeFrom());
 
   if (!useOptimalFilterSize) {
-    setTransitionLength(FIRFilter::getTransitionLength(
-        samplingRate, attenuationDB, filterSize));
+    setTransitionLength(getFilterTransitionLength());
   }
 
   emit controlsStateChanged();
@@ -205,8 +228,7 @@ void Backend::setUseOptimalFilterSize(bool value) {
   useOptimalFilterSize = value;
 
   if (useOptimalFilterSize) {
-    setFilterSize(FIRFilter::getOptimalCoefficientsCount(
-        samplingRate, attenuationDB, transitionLength));
+    setFilterSize(getOptimalFilterSize());
   }
 
   emit controlsStateChanged();
@@ -224,60 +246,39 @@ QString Backend::getCoefficientsString() const {
   return QString::fromStdString(s);
 }
 
-template <typename ForwardIt>
-double getMinFiniteValue(ForwardIt begin, ForwardIt end, ForwardIt limit) {
-  double minValue = 0;
-  for (auto iter = begin; iter < limit && iter < end; iter++) {
-    if (std::isfinite(*iter) && *iter < minValue) {
-      minValue = *iter;
-    }
-  }
-  return minValue;
-}
-
-template <typename ForwardIt>
-double getMaxFiniteValue(ForwardIt begin, ForwardIt end, ForwardIt limit) {
-  double maxValue = 0;
-  for (auto iter = begin; iter < limit && iter < end; iter++) {
-    if (std::isfinite(*iter) && *iter > maxValue) {
-      maxValue = *iter;
-    }
-  }
-  return maxValue;
-}
-
 int Backend::getCoefficientsCount() const { return coefficients.size(); }
 double Backend::getCoefficientsMinValue() const {
+  if (coefficients.empty()) {
+    return 0;
+  }
   return *std::min_element(coefficients.begin(), coefficients.end());
 }
 double Backend::getCoefficientsMaxValue() const {
+  if (coefficients.empty()) {
+    return 0;
+  }
   return *std::max_element(coefficients.begin(), coefficients.end());
 }
 
+/**
+ * Chart ranges always include 0, non-finite values are ignored
+ */
 double Backend::getFrequencyResponseMinValue() const {
-  auto magnitudeResponse = magnitudes(filterResponse);
-  return getMinFiniteValue(magnitudeResponse.begin() + visibleFrequencyFrom - 1,
-                           magnitudeResponse.begin() + visibleFrequencyTo - 1,
-                           magnitudeResponse.end());
+  const auto [from, to] = getVisibleResponseRange();
+  return std::min(0.0, responseMagnitudesRange.getMin(from, to));
 }
 double Backend::getFrequencyResponseMaxValue() const {
-  auto magnitudeResponse = magnitudes(filterResponse);
-  return getMaxFiniteValue(magnitudeResponse.begin() + visibleFrequencyFrom - 1,
-                           magnitudeResponse.begin() + visibleFrequencyTo - 1,
-                           magnitudeResponse.end());
+  const auto [from, to] = getVisibleResponseRange();
+  return std::max(0.0, responseMagnitudesRange.getMax(from, to));
 }
 
 double Backend::getPhaseResponseMinValue() const {
-  auto shifts = phaseShifts(filterResponse);
-  return getMinFiniteValue(shifts.begin() + visibleFrequencyFrom - 1,
-                           shifts.begin() + visibleFrequencyTo - 1,
-                           shifts.end());
+  const auto [from, to] = getVisibleResponseRange();
+  return std::min(0.0, responsePhaseShiftsRange.getMin(from, to));
 }
 double Backend::getPhaseResponseMaxValue() const {
-  auto shifts = phaseShifts(filterResponse);
-  return getMaxFiniteValue(shifts.begin() + visibleFrequencyFrom - 1,
-                           shifts.begin() + visibleFrequencyTo - 1,
-                           shifts.end());
+  const auto [from, to] = getVisibleResponseRange();
+  return std::max(0.0, responsePhaseShiftsRange.getMax(from, to));
 }
 
 int Backend::getVisibleFrequencyFrom() const { return visibleFrequencyFrom; }
@@ -303,49 +304,248 @@ void Backend::setVisibleFrequencyTo(int value) {
 }
 
 /**
- * Recalculate coefficients and filter frequency response
+ * IIR filter orders, capped equiripple and windowed FIR filter sizes
  */
-void Backend::recalculateCoefficientsAndFrequencyResponse() {
-  std::unique_ptr<Filter> filter;
-  std::unique_ptr<Window> window;
-
-  if (filterType == FilterType::fir) {
+ValueRange Backend::getFilterSizeRange() const {
+  if (FilterCalculator::getIIRApproximation(filterType)) {
+    return defaultIIROrderRange;
+  }
+  if (filterType == FilterType::remez) {
+    return defaultRemezFilterSizeRange;
+  }
+  return defaultFilterSizeRange;
+}
 
-    qInfo() << "FIR pass=" << toString(passType)
-            << "; cutoffFrequency=" << cutoffFrequency
-            << "; filterSize=" << filterSize
-            << "; window=" << toString(windowType)
-            << "; samplingRate=" << samplingRate << "\n";
+/**
+ * Estimated shortest filter reaching the attenuation with the selected window
+ * or equiripple design, lowest order of IIR filters.
+ * Windowed filter estimate is refined on the calculator thread.
+ */
+int Backend::getOptimalFilterSize() const {
+  if (const auto approximation =
+          FilterCalculator::getIIRApproximation(filterType)) {
+    try {
+      return SOSFilter::getOptimalOrder(*approximation, passType,
+                                        cutoffFrequency, transitionLength,
+                                        attenuationDB, samplingRate);
+    } catch (const std::invalid_argument &) {
+      // stop band is out of range, keep the current order
+      return filterSize;
+    }
+  }
+  if (filterType == FilterType::remez) {
+    return RemezFilter::getOptimalCoefficientsCount(samplingRate, attenuationDB,
+                                                    transitionLength);
+  }
+  const auto window = FilterCalculator::createWindow(windowType, attenuationDB);
+  return FIRFilter::getOptimalCoefficientsCount(samplingRate, *window,
+                                                transitionLength);
+}
 
-    if (windowType == WindowType::blackman) {
-      window = std::unique_ptr<Window>(new BlackmanWindow());
-    } else {
-      window = std::unique_ptr<Window>(new RectangularWindow());
+/**
+ * Transition length reached by the current filter size
+ */
+int Backend::getFilterTransitionLength() const {
+  if (const auto approximation =
+          FilterCalculator::getIIRApproximation(filterType)) {
+    // shortest transition the order is enough for
+    auto reached = [&](int length) {
+      try {
+        return SOSFilter::getOptimalOrder(*approximation, passType,
+                                          cutoffFrequency, length,
+                                          attenuationDB, samplingRate) <=
+               filterSize;
+      } catch (const std::invalid_argument &) {
+        return false;
+      }
+    };
+    int from = getTransitionLengthRangeFrom();
+    int to = getTransitionLengthRangeTo();
+    if (!reached(to)) {
+      return transitionLength;
+    }
+    while (from < to) {
+      const int middle = from + (to - from) / 2;
+      if (reached(middle)) {
+        to = middle;
+      } else {
+        from = middle + 1;
+      }
     }
+    return from;
+  }
+  if (filterType == FilterType::remez) {
+    return RemezFilter::getTransitionLength(
+        samplingRate, attenuationDB,
+        std::max(filterSize, defaultRemezFilterSizeRange.from));
+  }
+  const auto window = FilterCalculator::createWindow(windowType, attenuationDB);
+  return FIRFilter::getTransitionLength(samplingRate, *window,
+                                        std::max(filterSize, 2));
+}
 
-    filter = std::unique_ptr<Filter>(new FIRFilter(
-        passType, cutoffFrequency, filterSize, *window, samplingRate));
+/**
+ * @return true if windowed filter size, or transition length reached by
+ * the entered size, is the estimate, which measured designs may improve
+ */
+bool Backend::isFilterSizeEstimated() const {
+  if (filterType != FilterType::fir) {
+    return false;
+  }
+  if (useOptimalFilterSize) {
+    // estimates beyond the range are clamped, measuring them is pointless
+    const int estimate = getOptimalFilterSize();
+    return estimate == filterSize && estimate <= getFilterSizeRangeTo();
+  }
+  return transitionLength ==
+         std::max(std::min(getFilterTransitionLength(),
+                           getTransitionLengthRangeTo()),
+                  getTransitionLengthRangeFrom());
+}
 
+/**
+ * Keep filter size optimal for the controls, or update the transition
+ * length reached by the entered size
+ */
+void Backend::updateFilterSize() {
+  if (useOptimalFilterSize) {
+    setFilterSize(getOptimalFilterSize());
   } else {
-    qInfo() << "IIR pass=" << toString(passType)
-            << "; cutoffFrequency=" << cutoffFrequency
-            << "; filterSize=" << filterSize
-            << "; samplingRate=" << samplingRate << "\n";
-
-    if (passType == FilterPass::lowPass) {
-        filter = std::unique_ptr<Filter>(new LowPassRCCircuit(cutoffFrequency, samplingRate));
-    } else {
-        filter = std::unique_ptr<Filter>(new HighPassCRCircuit(cutoffFrequency, samplingRate));
-    }
+    setFilterSize(std::min(std::max(filterSize, getFilterSizeRangeFrom()),
+                           getFilterSizeRangeTo()));
+    setTransitionLength(getFilterTransitionLength());
+  }
+}
+
+FilterParameters Backend::getFilterParameters() const {
+  return {filterType,    passType,         cutoffFrequency, filterSize,
+          windowType,    attenuationDB,    transitionLength, samplingRate};
+}
+
+/**
+ * Request coefficients and filter frequency response recalculation
+ * on the calculator thread. Any previously requested calculation
+ * which hasn't completed yet is cancelled.
+ *
+ * Recently shown designs are taken from the cache without recalculation.
+ * Estimated windowed filter size or transition length is refined after
+ * the design is calculated.
+ */
+void Backend::recalculateCoefficientsAndFrequencyResponse() {
+  const quint64 generation = ++latestGeneration;
+  const FilterParameters parameters = getFilterParameters();
+
+  if (const auto cached = calculationsCache.get(parameters)) {
+    showCalculation(*cached);
+  } else {
+    QMetaObject::invokeMethod(
+        calculator,
+        [calculator = calculator, generation, parameters]() {
+          calculator->calculate(generation, parameters);
+        },
+        Qt::QueuedConnection);
+  }
+
+  // estimated design is shown first, measured one follows
+  if (isFilterSizeEstimated()) {
+    QMetaObject::invokeMethod(
+        calculator,
+        [calculator = calculator, generation, parameters,
+         useOptimalFilterSize = useOptimalFilterSize]() {
+          calculator->refineFilterSize(generation, parameters,
+                                       useOptimalFilterSize);
+        },
+        Qt::QueuedConnection);
   }
+}
 
-  coefficients = filter->getFilterCoefficients();
+bool Backend::isResponseComplete() const { return responseComplete; }
 
-  filterResponse = filter->calculateResponse();
+/**
+ * Accept calculation results if they match the current controls.
+ * Coarse responses of the current controls are applied too,
+ * each of them is followed by a more detailed one.
+ */
+void Backend::applyCalculation(FilterCalculation result) {
+  if (result.generation != latestGeneration.load() ||
+      !(result.parameters == getFilterParameters())) {
+    return;
+  }
+
+  if (result.complete) {
+    calculationsCache.put(result.parameters, result, result.getMemorySize());
+  }
+  showCalculation(std::move(result));
+}
+
+/**
+ * Accept measured filter size, or transition length reached by the entered
+ * size, if the controls haven't changed since the refinement was requested
+ */
+void Backend::applyFilterSizeRefinement(quint64 generation,
+                                        FilterParameters parameters) {
+  if (generation != latestGeneration.load()) {
+    return;
+  }
+
+  if (useOptimalFilterSize) {
+    setFilterSize(parameters.filterSize);
+  } else {
+    setTransitionLength(parameters.transitionLength);
+  }
+}
+
+/**
+ * Replace shown coefficients and response
+ */
+void Backend::showCalculation(FilterCalculation result) {
+  coefficients = std::move(result.coefficients);
+  response = std::move(result.response);
+  responseMagnitudesRange = std::move(result.magnitudesRange);
+  responsePhaseShiftsRange = std::move(result.phaseShiftsRange);
+  responseComplete = result.complete;
 
   emit calculationCompleted();
 }
 
+/**
+ * Chart width in pixels series points are decimated to
+ */
+int Backend::getChartWidth(QAbstractSeries *series) {
+  auto chart = series->chart();
+  if (chart && chart->plotArea().width() > 0) {
+    return static_cast<int>(chart->plotArea().width());
+  }
+  return defaultChartWidth;
+}
+
+/**
+ * Replace QML LineSeries points with min/max decimated data,
+ * at most 2 points per chart pixel are kept
+ *
+ * @param series QML LineSeries
+ * @param x ascending x values
+ * @param y y values
+ * @param from first point index
+ * @param to index after the last point
+ */
+void Backend::replaceSeriesPoints(QAbstractSeries *series,
+                                  std::span<const double> x,
+                                  std::span<const double> y, int from,
+                                  int to) {
+  const auto indices = decimateMinMax(x, y, from, to, getChartWidth(series));
+  QList<QPointF> points;
+  points.reserve(indices.size());
+
+  for (int j : indices) {
+    points.append(QPointF(x[j], y[j]));
+  }
+
+  auto xySeries = static_cast<QXYSeries *>(series);
+  // Use replace instead of clear + append, it's optimized for performance
+  xySeries->replace(points);
+}
+
 /**
  * Dynamically update QML LineSeries with new points
  */
@@ -353,19 +553,9 @@ void Backend::updateListSeries(QAbstractSeries *series,
                                const std::vector<double> &data, int from,
                                int to) {
   if (series) {
-    int dataSize = std::min(static_cast<int>(data.size()), to) - from;
-    QList<QPointF> points;
-    points.reserve(dataSize);
-
-    for (int j = from; j < dataSize + from; j++) {
-      qreal x = j;
-      qreal y = data[j];
-      points.append(QPointF(x, y));
-    }
-
-    auto xySeries = static_cast<QXYSeries *>(series);
-    // Use replace instead of clear + append, it's optimized for performance
-    xySeries->replace(points);
+    std::vector<double> indices(data.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    replaceSeriesPoints(series, indices, data, from, to);
   }
 }
 
@@ -375,11 +565,34 @@ void Backend::updateCoefficients(QAbstractSeries *series) {
 }
 
 void Backend::updateFrequencyResponse(QAbstractSeries *series) {
-  updateListSeries(series, magnitudes(filterResponse), visibleFrequencyFrom - 1,
-                   visibleFrequencyTo - 1);
+  updateResponseSeries(series, response.getMagnitudesDB());
 }
 
 void Backend::updatePhaseShifts(QAbstractSeries *series) {
-  updateListSeries(series, phaseShifts(filterResponse),
-                   visibleFrequencyFrom - 1, visibleFrequencyTo - 1);
+  updateResponseSeries(series, response.getPhaseShifts());
+}
+
+/**
+ * Indices of the response values within the visible frequency range
+ *
+ * @return [from, to) indices in response frequencies
+ */
+std::pair<int, int> Backend::getVisibleResponseRange() const {
+  const auto frequencies = response.getFrequencies();
+  auto from = std::lower_bound(frequencies.begin(), frequencies.end(),
+                               visibleFrequencyFrom);
+  auto to = std::lower_bound(from, frequencies.end(), visibleFrequencyTo);
+  return {from - frequencies.begin(), to - frequencies.begin()};
+}
+
+/**
+ * Update QML LineSeries with visible response values,
+ * response may be calculated at unevenly spaced frequencies
+ */
+void Backend::updateResponseSeries(QAbstractSeries *series,
+                                   std::span<const double> data) {
+  if (series) {
+    const auto [from, to] = getVisibleResponseRange();
+    replaceSeriesPoints(series, response.getFrequencies(), data, from, to);
+  }
 }
@@ -4,11 +4,18 @@
 #include <QList>
 #include <QObject>
 #include <QPointF>
+#include <QThread>
+#include <atomic>
+#include <span>
+#include <utility>
 #include <vector>
 #include "ListSelectorValues.hpp"
 #include "ValueRange.hpp"
 #include "DefaultControlValues.hpp"
-#include "../shared/FilterResponse.hpp"
+#include "FilterCalculator.hpp"
+#include "FilterParameters.hpp"
+#include "../shared/LRUCache.hpp"
+#include "../shared/RangeMinMax.hpp"
 
 QT_FORWARD_DECLARE_CLASS(QAbstractSeries)
 
@@ -17,6 +24,7 @@ class Backend : public QObject {
 
 public:
   explicit Backend(QObject *parent = nullptr);
+  ~Backend();
 
   Q_INVOKABLE int getSamplingRate() const;
   Q_INVOKABLE int getSamplingRateRangeFrom() const;
@@ -56,6 +64,7 @@ public:
 
   Q_INVOKABLE double getPhaseResponseMaxValue() const;
   Q_INVOKABLE double getPhaseResponseMinValue() const;
+  Q_INVOKABLE bool isResponseComplete() const;
 
   Q_INVOKABLE int getVisibleFrequencyFrom() const;
   Q_INVOKABLE int getVisibleFrequencyTo() const;
@@ -77,6 +86,11 @@ public slots:
   void updateFrequencyResponse(QAbstractSeries *series);
   void updatePhaseShifts(QAbstractSeries *series);
 
+private slots:
+  void applyCalculation(FilterCalculation result);
+  void applyFilterSizeRefinement(quint64 generation,
+                                 FilterParameters parameters);
+
 signals:
   void controlsStateChanged();
   void recalculationNeeded();
@@ -95,10 +109,40 @@ private:
   int visibleFrequencyFrom = defaultVisibleFrequencyRange.from;
   int visibleFrequencyTo = defaultVisibleFrequencyRange.to;
   std::vector<double> coefficients;
-  std::vector<FilterResponse> filterResponse;
-
+  // response is calculated coarse-to-fine at these frequencies (Hz)
+  FrequencyResponse<> response;
+  RangeMinMax responseMagnitudesRange;
+  RangeMinMax responsePhaseShiftsRange;
+  bool responseComplete = false;
+
+  // filters are calculated on a separate thread,
+  // only the latest requested calculation is applied
+  QThread calculatorThread;
+  FilterCalculator *calculator;
+  std::atomic<quint64> latestGeneration{0};
+
+  // complete calculations of recently shown designs
+  LRUCache<FilterParameters, FilterCalculation, FilterParametersHash>
+      calculationsCache{calculationsCacheMaxEntries,
+                        calculationsCacheMaxBytes};
+
+  FilterParameters getFilterParameters() const;
+  ValueRange getFilterSizeRange() const;
+  int getOptimalFilterSize() const;
+  int getFilterTransitionLength() const;
+  bool isFilterSizeEstimated() const;
+  void updateFilterSize();
+  void showCalculation(FilterCalculation result);
+  static int getChartWidth(QAbstractSeries *series);
+  static void replaceSeriesPoints(QAbstractSeries *series,
+                                  std::span<const double> x,
+                                  std::span<const double> y, int from,
+                                  int to);
   void updateListSeries(QAbstractSeries *series,
                         const std::vector<double> &data, int from, int to);
+  std::pair<int, int> getVisibleResponseRange() const;
+  void updateResponseSeries(QAbstractSeries *series,
+                            std::span<const double> data);
 };
 
 #endif // BACKEND_H
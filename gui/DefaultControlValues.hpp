@@ -3,6 +3,7 @@
 
 #include "ValueRange.hpp"
 #include "ListSelectorValues.hpp"
+#include <cstddef>
 
 constexpr int defaultSamplingRate = 48000;
 constexpr ValueRange defaultSamplingRateRange{2, 200000};
@@ -19,6 +20,10 @@ constexpr ValueRange defaultTransitionLengthRange{10, 1000};
 constexpr int defaultFilterSize = 201;
 constexpr ValueRange defaultFilterSizeRange{2, 10000};
 constexpr bool defaultUseOptimalFilterSize = true;
+// each exchange iteration is quadratic in the size of equiripple filters
+constexpr ValueRange defaultRemezFilterSizeRange{3, 2048};
+// size is the order of IIR filters made of second order sections
+constexpr ValueRange defaultIIROrderRange{1, 20};
 
 constexpr FilterPass defaultPassType = FilterPass::lowPass;
 
@@ -29,5 +34,11 @@ constexpr WindowType defaultWindowType = WindowType::blackman;
 constexpr ValueRange defaultVisibleFrequencyRange{1, defaultSamplingRate / 2};
 constexpr int minVisibleFrequencyResponseTo = 1000;
 constexpr int displayedFrequencyResponseCutoffMult = 4;
+// recently calculated designs are kept to be shown again instantly
+constexpr int calculationsCacheMaxEntries = 32;
+constexpr std::size_t calculationsCacheMaxBytes = 128 * 1024 * 1024;
+
+// used to decimate series until the chart is laid out
+constexpr int defaultChartWidth = 1000;
 
 #endif // DEFAULTCONTROLVALUES_H
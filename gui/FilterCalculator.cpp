@@ -0,0 +1,268 @@
+#include "FilterCalculator.hpp"
+#include "../shared/ProgressiveResponse.hpp"
+#include "../shared/Sampling.hpp"
+#include "../shared/fir/BlackmanWindow.hpp"
+#include "../shared/fir/ChebyshevWindow.hpp"
+#include "../shared/fir/FIRFilter.hpp"
+#include "../shared/fir/HammingWindow.hpp"
+#include "../shared/fir/HannWindow.hpp"
+#include "../shared/fir/KaiserWindow.hpp"
+#include "../shared/fir/NuttallWindow.hpp"
+#include "../shared/fir/RectangularWindow.hpp"
+#include "../shared/fir/RemezFilter.hpp"
+#include "../shared/iir/HighPassCRCircuit.hpp"
+#include "../shared/iir/LowPassRCCircuit.hpp"
+#include "../shared/iir/SOSFilter.hpp"
+#include <QDebug>
+#include <memory>
+#include <stdexcept>
+
+FilterCalculator::FilterCalculator(const std::atomic<quint64> &latestGeneration,
+                                   QObject *parent)
+    : QObject{parent}, latestGeneration{latestGeneration} {}
+
+/**
+ * @return true if a newer calculation was requested meanwhile
+ */
+bool FilterCalculator::isStale(quint64 generation) const {
+  return generation != latestGeneration.load();
+}
+
+/**
+ * Create FIR filter window
+ *
+ * @param attenuationDB target attenuation Kaiser and Chebyshev windows are
+ * shaped for, other windows have a fixed one
+ */
+std::unique_ptr<Window> FilterCalculator::createWindow(WindowType windowType,
+                                                       double attenuationDB) {
+  switch (windowType) {
+  case WindowType::blackman:
+    return std::unique_ptr<Window>(new BlackmanWindow());
+  case WindowType::rectangular:
+    return std::unique_ptr<Window>(new RectangularWindow());
+  case WindowType::hann:
+    return std::unique_ptr<Window>(new HannWindow());
+  case WindowType::hamming:
+    return std::unique_ptr<Window>(new HammingWindow());
+  case WindowType::nuttall:
+    return std::unique_ptr<Window>(new NuttallWindow());
+  case WindowType::kaiser:
+    return std::unique_ptr<Window>(new KaiserWindow(attenuationDB));
+  case WindowType::chebyshev:
+    return std::unique_ptr<Window>(new ChebyshevWindow(attenuationDB));
+  }
+  throw std::logic_error("Unknown window type");
+}
+
+/**
+ * @return analog prototype of the filter types designed as a cascade of
+ * second order sections
+ */
+std::optional<IIRApproximation>
+FilterCalculator::getIIRApproximation(FilterType filterType) {
+  switch (filterType) {
+  case FilterType::butterworth:
+    return IIRApproximation::butterworth;
+  case FilterType::chebyshev:
+    return IIRApproximation::chebyshev;
+  case FilterType::elliptic:
+    return IIRApproximation::elliptic;
+  default:
+    return std::nullopt;
+  }
+}
+
+/**
+ * Create filter for the given controls
+ *
+ * @param window FIR filter window, must outlive the filter
+ * @param isCancelled abandons long equiripple designs
+ */
+std::unique_ptr<Filter>
+FilterCalculator::createFilter(const FilterParameters &parameters,
+                               std::unique_ptr<Window> &window,
+                               const std::function<bool()> &isCancelled) {
+  if (parameters.filterType == FilterType::fir) {
+
+    qInfo() << "FIR pass=" << toString(parameters.passType)
+            << "; cutoffFrequency=" << parameters.cutoffFrequency
+            << "; filterSize=" << parameters.filterSize
+            << "; window=" << toString(parameters.windowType)
+            << "; attenuationDB=" << parameters.attenuationDB
+            << "; samplingRate=" << parameters.samplingRate << "\n";
+
+    window = createWindow(parameters.windowType, parameters.attenuationDB);
+
+    return std::unique_ptr<Filter>(new FIRFilter(
+        parameters.passType, parameters.cutoffFrequency, parameters.filterSize,
+        *window, parameters.samplingRate));
+  }
+
+  if (parameters.filterType == FilterType::remez) {
+
+    qInfo() << "FIR Equiripple pass=" << toString(parameters.passType)
+            << "; cutoffFrequency=" << parameters.cutoffFrequency
+            << "; filterSize=" << parameters.filterSize
+            << "; transitionLength=" << parameters.transitionLength
+            << "; attenuationDB=" << parameters.attenuationDB
+            << "; samplingRate=" << parameters.samplingRate << "\n";
+
+    return std::unique_ptr<Filter>(new RemezFilter(
+        parameters.passType, parameters.cutoffFrequency,
+        parameters.transitionLength, parameters.attenuationDB,
+        parameters.filterSize, parameters.samplingRate,
+        RemezFilter::defaultPassBandRippleDB, isCancelled));
+  }
+
+  if (const auto approximation = getIIRApproximation(parameters.filterType)) {
+
+    qInfo() << toString(parameters.filterType)
+            << " pass=" << toString(parameters.passType)
+            << "; cutoffFrequency=" << parameters.cutoffFrequency
+            << "; order=" << parameters.filterSize
+            << "; attenuationDB=" << parameters.attenuationDB
+            << "; samplingRate=" << parameters.samplingRate << "\n";
+
+    return std::unique_ptr<Filter>(new SOSFilter(
+        *approximation, parameters.passType, parameters.filterSize,
+        parameters.cutoffFrequency, parameters.attenuationDB,
+        parameters.samplingRate));
+  }
+
+  qInfo() << "IIR pass=" << toString(parameters.passType)
+          << "; cutoffFrequency=" << parameters.cutoffFrequency
+          << "; filterSize=" << parameters.filterSize
+          << "; samplingRate=" << parameters.samplingRate << "\n";
+
+  if (parameters.passType == FilterPass::lowPass) {
+    return std::unique_ptr<Filter>(new LowPassRCCircuit(
+        parameters.cutoffFrequency, parameters.samplingRate));
+  }
+  return std::unique_ptr<Filter>(new HighPassCRCircuit(
+      parameters.cutoffFrequency, parameters.samplingRate));
+}
+
+/**
+ * Unwrap phases and index magnitudes and phases once,
+ * so that charts don't have to do it on every redraw
+ */
+void FilterCalculator::setResponse(FilterCalculation &result,
+                                   FrequencyResponse<> response) {
+  response.unwrapPhaseShifts();
+  result.response = std::move(response);
+  result.magnitudesRange = RangeMinMax(result.response.getMagnitudesDB());
+  result.phaseShiftsRange = RangeMinMax(result.response.getPhaseShifts());
+}
+
+/**
+ * Calculate coefficients and filter frequency response.
+ * Queued requests superseded by a newer one are dropped without any work,
+ * so that a burst of control changes results in a single calculation.
+ *
+ * Coarse response is emitted right away, so that charts follow the controls
+ * while they're being dragged. Refinement passes and the full response are
+ * calculated only if no newer request arrives meanwhile.
+ */
+void FilterCalculator::calculate(quint64 generation,
+                                 FilterParameters parameters) {
+  if (isStale(generation)) {
+    return;
+  }
+
+  FilterCalculation result;
+  result.generation = generation;
+  result.parameters = parameters;
+
+  try {
+    std::unique_ptr<Window> window;
+    auto filter = createFilter(parameters, window,
+                               [&] { return isStale(generation); });
+    if (isStale(generation)) {
+      return;
+    }
+    result.coefficients = filter->getFilterCoefficients();
+
+    const int fromFrequency = 1;
+    const int toFrequency = nyquistFrequency(parameters.samplingRate) - 1;
+
+    ProgressiveResponse progressive(*filter, fromFrequency, toFrequency, 1,
+                                    coarseResponsePointsCount);
+    for (int pass = 0;; pass++) {
+      setResponse(result, progressive.getFrequencyResponse());
+      result.complete = progressive.isComplete();
+      if (isStale(generation)) {
+        return;
+      }
+      emit calculated(result);
+
+      if (result.complete || pass == refinementPassesCount) {
+        break;
+      }
+      progressive.refine(progressive.size());
+    }
+
+    if (result.complete || isStale(generation)) {
+      return;
+    }
+
+    // full response is calculated at once, it's cheaper than refining
+    // up to every frequency
+    const auto grid = FrequencyGrid::linear(
+        fromFrequency, toFrequency, toFrequency - fromFrequency + 1);
+    setResponse(result, filter->calculateFrequencyResponse(grid));
+    result.complete = true;
+  } catch (const std::exception &e) {
+    // controls may be in an intermediate state while being changed
+    qWarning() << "Filter calculation failed: " << e.what();
+    return;
+  }
+
+  if (isStale(generation)) {
+    return;
+  }
+  emit calculated(result);
+}
+
+/**
+ * Measure designed windowed filters to find the shortest one reaching
+ * the attenuation, or the transition length reached by the entered size.
+ * Parameters with the refined value are emitted only if it differs from
+ * the estimate.
+ *
+ * @param useOptimalFilterSize refine filter size if true, transition length
+ * otherwise
+ */
+void FilterCalculator::refineFilterSize(quint64 generation,
+                                        FilterParameters parameters,
+                                        bool useOptimalFilterSize) {
+  if (isStale(generation) || parameters.filterType != FilterType::fir) {
+    return;
+  }
+
+  FilterParameters refined = parameters;
+  try {
+    const auto window =
+        createWindow(parameters.windowType, parameters.attenuationDB);
+    if (useOptimalFilterSize) {
+      refined.filterSize = FIRFilter::findOptimalCoefficientsCount(
+          parameters.passType, parameters.cutoffFrequency,
+          parameters.transitionLength, window->getAttenuationDB(), *window,
+          parameters.samplingRate, [&] { return isStale(generation); });
+    } else {
+      refined.transitionLength = FIRFilter::findTransitionLength(
+          parameters.passType, parameters.cutoffFrequency,
+          parameters.filterSize, window->getAttenuationDB(), *window,
+          parameters.samplingRate);
+    }
+  } catch (const std::invalid_argument &) {
+    // window doesn't reach its attenuation or transition band is out of range,
+    // the estimate stays
+    return;
+  }
+
+  if (isStale(generation) || refined == parameters) {
+    return;
+  }
+  emit filterSizeRefined(generation, refined);
+}
@@ -0,0 +1,95 @@
+#ifndef FILTERCALCULATOR_H
+#define FILTERCALCULATOR_H
+
+#include <QMetaType>
+#include <QObject>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "FilterParameters.hpp"
+#include "../shared/Filter.hpp"
+#include "../shared/FrequencyResponse.hpp"
+#include "../shared/RangeMinMax.hpp"
+#include "../shared/fir/Window.hpp"
+#include "../shared/iir/AnalogPrototype.hpp"
+
+/**
+ * Filter coefficients and response calculated for the given parameters
+ */
+struct FilterCalculation {
+  quint64 generation = 0;
+  FilterParameters parameters{};
+  std::vector<double> coefficients;
+  // response at ascending frequencies (Hz) with unwrapped phase shifts
+  FrequencyResponse<> response;
+  // visible range limits are queried on every pan and zoom
+  RangeMinMax magnitudesRange;
+  RangeMinMax phaseShiftsRange;
+  // false for coarse responses followed by more detailed ones
+  bool complete = false;
+
+  /**
+   * @return approximate memory taken by coefficients and response in bytes
+   */
+  std::size_t getMemorySize() const {
+    return sizeof(double) * (coefficients.size() + 3 * response.size()) +
+           magnitudesRange.getMemorySize() + phaseShiftsRange.getMemorySize();
+  }
+};
+
+Q_DECLARE_METATYPE(FilterParameters)
+Q_DECLARE_METATYPE(FilterCalculation)
+
+/**
+ * Designs filters on a worker thread.
+ * Every request is tagged with a generation number, requests older than the
+ * latest one are skipped or abandoned as soon as possible.
+ *
+ * Response is delivered progressively: a coarse one first, then refined
+ * where it changes fastest, then the full one with a point per Hz.
+ *
+ * Windowed filter size and transition length estimates are refined here too,
+ * by measuring the designed filters.
+ */
+class FilterCalculator : public QObject {
+  Q_OBJECT
+
+public:
+  // response points of the first, coarse, pass
+  static constexpr int coarseResponsePointsCount = 256;
+  // each pass doubles the number of points before the full response
+  static constexpr int refinementPassesCount = 3;
+
+  explicit FilterCalculator(const std::atomic<quint64> &latestGeneration,
+                            QObject *parent = nullptr);
+
+  static std::unique_ptr<Window> createWindow(WindowType windowType,
+                                              double attenuationDB);
+  static std::optional<IIRApproximation>
+  getIIRApproximation(FilterType filterType);
+
+public slots:
+  void calculate(quint64 generation, FilterParameters parameters);
+  void refineFilterSize(quint64 generation, FilterParameters parameters,
+                        bool useOptimalFilterSize);
+
+signals:
+  void calculated(FilterCalculation result);
+  void filterSizeRefined(quint64 generation, FilterParameters parameters);
+
+private:
+  const std::atomic<quint64> &latestGeneration;
+
+  bool isStale(quint64 generation) const;
+  static void setResponse(FilterCalculation &result,
+                          FrequencyResponse<> response);
+  static std::unique_ptr<Filter>
+  createFilter(const FilterParameters &parameters,
+               std::unique_ptr<Window> &window,
+               const std::function<bool()> &isCancelled);
+};
+
+#endif // FILTERCALCULATOR_H
@@ -0,0 +1,43 @@
+#ifndef FILTERPARAMETERS_H
+#define FILTERPARAMETERS_H
+
+#include "ListSelectorValues.hpp"
+#include "../shared/FilterPass.hpp"
+#include <cstddef>
+#include <functional>
+
+/**
+ * Snapshot of the controls a filter design depends on
+ */
+struct FilterParameters {
+    FilterType filterType;
+    FilterPass passType;
+    int cutoffFrequency;
+    int filterSize;
+    WindowType windowType;
+    // Kaiser and Chebyshev windows are shaped for the attenuation,
+    // equiripple filters are designed for both
+    int attenuationDB;
+    int transitionLength;
+    int samplingRate;
+
+    bool operator==(const FilterParameters &other) const = default;
+};
+
+struct FilterParametersHash {
+    std::size_t operator()(const FilterParameters &parameters) const {
+        std::size_t hash = 0;
+        for (const int value :
+             {static_cast<int>(parameters.filterType),
+              static_cast<int>(parameters.passType),
+              parameters.cutoffFrequency, parameters.filterSize,
+              static_cast<int>(parameters.windowType),
+              parameters.attenuationDB, parameters.transitionLength,
+              parameters.samplingRate}) {
+            hash = hash * 31 + std::hash<int>{}(value);
+        }
+        return hash;
+    }
+};
+
+#endif // FILTERPARAMETERS_H
@@ -4,23 +4,41 @@
 #include <string>
 #include "../shared/FilterPass.hpp"
 
-enum class WindowType { blackman, rectangular };
+enum class WindowType {
+  blackman,
+  rectangular,
+  hann,
+  hamming,
+  nuttall,
+  kaiser,
+  chebyshev
+};
 
 const struct {
   WindowType val;
   std::string str;
 } windowTypes[] = {{WindowType::blackman, "Blackman"},
-                   {WindowType::rectangular, "Rectangular"}};
+                   {WindowType::rectangular, "Rectangular"},
+                   {WindowType::hann, "Hann"},
+                   {WindowType::hamming, "Hamming"},
+                   {WindowType::nuttall, "Nuttall"},
+                   {WindowType::kaiser, "Kaiser"},
+                   {WindowType::chebyshev, "Dolph-Chebyshev"}};
 
 std::string toString(WindowType t);
 WindowType toWindowType(std::string str);
 
-enum class FilterType { fir, iir };
+enum class FilterType { fir, remez, iir, butterworth, chebyshev, elliptic };
 
 const struct {
   FilterType val;
   std::string str;
-} filterTypes[] = {{FilterType::fir, "FIR"}, {FilterType::iir, "IIR"}};
+} filterTypes[] = {{FilterType::fir, "FIR"},
+                   {FilterType::remez, "FIR Equiripple"},
+                   {FilterType::iir, "IIR"},
+                   {FilterType::butterworth, "IIR Butterworth"},
+                   {FilterType::chebyshev, "IIR Chebyshev"},
+                   {FilterType::elliptic, "IIR Elliptic"}};
 
 std::string toString(FilterType t);
 FilterType toFilterType(std::string str);
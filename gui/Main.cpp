@@ -1,12 +1,28 @@
 #include <QApplication>
+#include <QDir>
 #include <QQmlApplicationEngine>
+#include <QStandardPaths>
 #include "Backend.hpp"
+#include "../shared/FFT.hpp"
 
 using namespace std;
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
 
+    // Measured FFT plans are persisted as FFTW wisdom,
+    // so that planning is done only once per transform size.
+    // Sizes like samplingRate are estimated unless the wisdom has them
+    const QString dataDir =
+        QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    const QString wisdomPath = QDir(dataDir).filePath("fftw.wisdom");
+    fft::importWisdom(wisdomPath.toStdString());
+    fft::setPlanningMode(fft::PlanningMode::measure);
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [dataDir, wisdomPath]() {
+        QDir().mkpath(dataDir);
+        fft::exportWisdom(wisdomPath.toStdString());
+    });
+
     qmlRegisterType<Backend>("filter.designer.qmlcomponents", 1, 0, "Backend");
 
     QQmlApplicationEngine engine;
@@ -89,24 +89,24 @@ ColumnLayout {
             Label {
                 id: windowTypeLabel
                 text: qsTr("Window")
-                visible: isFIR()
+                visible: isWindowedFIR()
             }
             ComboBox {
                 id: windowType
                 Layout.fillWidth: true
                 model: backend.getWindowTypes()
-                visible: isFIR()
+                visible: isWindowedFIR()
                 onCurrentValueChanged: backend.setWindowType(currentValue)
             }
 
             Label {
                 id: attenuationDBLabel
                 text: qsTr("Attenuation (dB)")
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
             }
             RowLayout {
                 id: attenuationDBControls
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
                 Layout.fillWidth: true
 
                 SpinBox {
@@ -139,12 +139,12 @@ ColumnLayout {
             Label {
                 id: transitionLengthLabel
                 text: qsTr("Transition Length (Hz)")
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
             }
             SpinBox {
                 id: transitionLength
                 enabled: useOptimalFilterSize.checked
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
                 Layout.fillWidth: true
                 editable: true
                 from: backend.getTransitionLengthRangeFrom()
@@ -156,7 +156,7 @@ ColumnLayout {
             CheckBox {
                 id: useOptimalFilterSize
                 text: qsTr("Optimal Filter Size")
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
                 Layout.fillWidth: true
                 leftPadding: 0
                 checked: backend.isUseOptimalFilterSize()
@@ -166,14 +166,14 @@ ColumnLayout {
             Label {
                 id: filterSizeLabel
                 text: qsTr("Size")
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
             }
             SpinBox {
                 id: filterSize
                 enabled: !useOptimalFilterSize.checked
                 Layout.fillWidth: true
                 editable: true
-                visible: isFIR()
+                visible: isDesignedForAttenuation()
                 from: backend.getFilterSizeRangeFrom()
                 to: backend.getFilterSizeRangeTo()
                 value: backend.getFilterSize()
@@ -275,15 +275,15 @@ ColumnLayout {
     Connections {
         target: backend
         function onControlsStateChanged() {
-            windowTypeLabel.visible = isFIR()
-            windowType.visible = isFIR()
-            attenuationDBLabel.visible = isFIR()
-            attenuationDBControls.visible = isFIR()
-            transitionLengthLabel.visible = isFIR()
-            transitionLength.visible = isFIR()
-            useOptimalFilterSize.visible = isFIR()
-            filterSizeLabel.visible = isFIR()
-            filterSize.visible = isFIR()
+            windowTypeLabel.visible = isWindowedFIR()
+            windowType.visible = isWindowedFIR()
+            attenuationDBLabel.visible = isDesignedForAttenuation()
+            attenuationDBControls.visible = isDesignedForAttenuation()
+            transitionLengthLabel.visible = isDesignedForAttenuation()
+            transitionLength.visible = isDesignedForAttenuation()
+            useOptimalFilterSize.visible = isDesignedForAttenuation()
+            filterSizeLabel.visible = isDesignedForAttenuation()
+            filterSize.visible = isDesignedForAttenuation()
 
             samplingRate.from = backend.getSamplingRateRangeFrom()
             samplingRate.to = backend.getSamplingRateRangeTo()
@@ -291,6 +291,10 @@ ColumnLayout {
             cutoffFrequency.from = backend.getCutoffFrequencyRangeFrom()
             cutoffFrequency.to = backend.getCutoffFrequencyRangeTo()
 
+            filterSizeLabel.text = isSecondOrderSectionsIIR() ? qsTr("Order")
+                                                              : qsTr("Size")
+            filterSize.from = backend.getFilterSizeRangeFrom()
+            filterSize.to = backend.getFilterSizeRangeTo()
             filterSize.value = backend.getFilterSize()
             transitionLength.value = backend.getTransitionLength()
 
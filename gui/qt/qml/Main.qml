@@ -33,9 +33,21 @@ ApplicationWindow {
     }
 
     function isFIR() {
+        return backend.getFilterType().startsWith("FIR")
+    }
+
+    function isWindowedFIR() {
         return backend.getFilterType() === "FIR"
     }
 
+    function isSecondOrderSectionsIIR() {
+        return backend.getFilterType().startsWith("IIR ")
+    }
+
+    function isDesignedForAttenuation() {
+        return isFIR() || isSecondOrderSectionsIIR()
+    }
+
     function isHighPass() {
         return backend.getPassType() === "High Pass"
     }
@@ -0,0 +1,14 @@
+#ifndef CHANNELLAYOUT_HPP
+#define CHANNELLAYOUT_HPP
+
+/**
+ * Multichannel samples buffer layout.
+ * planar: all samples of channel 0, then all samples of channel 1, ...
+ * interleaved: frames of one sample per channel, ch0 ch1 ... ch0 ch1 ...
+ */
+enum class ChannelLayout {
+    planar,
+    interleaved
+};
+
+#endif // CHANNELLAYOUT_HPP
@@ -0,0 +1,77 @@
+#include "Decimation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Reduce number of points to plot keeping peaks and notches.
+ *
+ * Points range is split into bucketsCount equal x intervals (e.g. one per
+ * pixel), only the minimum and maximum y of each bucket are kept in their
+ * original order. Line drawn through the kept points covers the same vertical
+ * extent in every bucket as the line through all points, so narrow stop band
+ * lobes and nulls stay visible. Cost is O(to - from), output size is at most
+ * 2 * bucketsCount.
+ *
+ * @param x ascending x values
+ * @param y y values
+ * @param from first point index
+ * @param to index after the last point
+ * @param bucketsCount number of buckets, e.g. chart width in pixels
+ * @return sorted indices of the points to keep
+ */
+vector<int> decimateMinMax(span<const double> x, span<const double> y,
+                           int from, int to, int bucketsCount) {
+  if (x.size() != y.size()) {
+    throw invalid_argument("decimateMinMax: x and y must be of the same size");
+  }
+  if (bucketsCount < 1) {
+    throw invalid_argument("decimateMinMax: bucketsCount must be >= 1");
+  }
+  from = max(from, 0);
+  to = min(to, static_cast<int>(x.size()));
+
+  vector<int> indices;
+  if (to - from <= 2 * bucketsCount) {
+    for (int i = from; i < to; i++) {
+      indices.push_back(i);
+    }
+    return indices;
+  }
+
+  indices.reserve(2 * bucketsCount);
+  const double fromX = x[from];
+  const double bucketWidth = (x[to - 1] - fromX) / bucketsCount;
+
+  int i = from;
+  for (int bucket = 0; bucket < bucketsCount && i < to; bucket++) {
+    const double bucketEnd =
+        bucket == bucketsCount - 1 ? INFINITY : fromX + (bucket + 1) * bucketWidth;
+
+    int minIndex = -1;
+    int maxIndex = -1;
+    for (; i < to && x[i] < bucketEnd; i++) {
+      if (isnan(y[i])) {
+        continue;
+      }
+      if (minIndex < 0 || y[i] < y[minIndex]) {
+        minIndex = i;
+      }
+      if (maxIndex < 0 || y[i] > y[maxIndex]) {
+        maxIndex = i;
+      }
+    }
+
+    if (minIndex < 0) {
+      continue;
+    }
+    indices.push_back(min(minIndex, maxIndex));
+    if (minIndex != maxIndex) {
+      indices.push_back(max(minIndex, maxIndex));
+    }
+  }
+
+  return indices;
+}
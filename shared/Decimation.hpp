@@ -0,0 +1,11 @@
+#ifndef DECIMATION_H
+#define DECIMATION_H
+
+#include <span>
+#include <vector>
+
+std::vector<int> decimateMinMax(std::span<const double> x,
+                                std::span<const double> y, int from, int to,
+                                int bucketsCount);
+
+#endif
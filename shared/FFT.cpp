@@ -1,9 +1,310 @@
 #include "FFT.hpp"
+#include "LRUCache.hpp"
 #include "fftw3.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
 
+namespace {
+
+/**
+ * Complex DFT or one of the real-input/real-output halves of it
+ */
+enum class TransformKind { complexToComplex, realToComplex, complexToReal };
+
+/**
+ * Cached plans are identified by transform kind, size, direction and whether
+ * the transform is performed in-place (single buffer) or out-of-place
+ */
+struct PlanKey {
+  TransformKind kind;
+  int size;
+  int direction;
+  bool inPlace;
+
+  bool operator==(const PlanKey &other) const = default;
+};
+
+struct PlanKeyHash {
+  size_t operator()(const PlanKey &key) const {
+    return ((hash<int>{}(static_cast<int>(key.kind)) * 31 +
+             hash<int>{}(key.size)) *
+                31 +
+            hash<int>{}(key.direction)) *
+               2 +
+           key.inPlace;
+  }
+};
+
+/**
+ * FFTW plan, executed on per-thread buffers of the same alignment
+ */
+struct CachedPlan {
+  fftw_plan plan = nullptr;
+
+  ~CachedPlan();
+};
+
+using PlanCache = LRUCache<PlanKey, shared_ptr<CachedPlan>, PlanKeyHash>;
+
+// least recently used plans are destroyed beyond these limits,
+// each thread keeps its own smaller set of recently used plans
+constexpr int planCacheMaxEntries = 64;
+constexpr int threadPlanCacheMaxEntries = 16;
+
+// FFTW planner (plan creation, destruction and wisdom) is not thread-safe
+recursive_mutex plannerMutex;
+PlanCache planCache{planCacheMaxEntries, numeric_limits<size_t>::max()};
+fft::PlanningMode planningMode = fft::PlanningMode::estimate;
+// incremented whenever cached plans are dropped
+atomic<unsigned int> planCacheGeneration{0};
+
+CachedPlan::~CachedPlan() {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+  fftw_destroy_plan(plan);
+}
+
+/**
+ * Aligned input and output buffers owned by a single thread.
+ * Executing a plan on new arrays is thread-safe, so threads transforming
+ * the same size share the plan without locking.
+ */
+struct ScratchBuffers {
+  fftw_complex *in = nullptr;
+  fftw_complex *out = nullptr;
+  int capacity = 0;
+
+  ~ScratchBuffers() {
+    fftw_free(in);
+    fftw_free(out);
+  }
+
+  void reserve(int size) {
+    if (size <= capacity) {
+      return;
+    }
+    fftw_free(in);
+    fftw_free(out);
+    in = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * size);
+    out = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * size);
+    capacity = size;
+  }
+};
+
+/**
+ * Plans already looked up by the current thread,
+ * so that repeated transforms don't contend on the planner mutex
+ */
+struct ThreadPlanCache {
+  unsigned int generation = 0;
+  PlanCache plans{threadPlanCacheMaxEntries, numeric_limits<size_t>::max()};
+};
+
+thread_local ScratchBuffers scratchBuffers;
+thread_local ThreadPlanCache threadPlanCache;
+
+bool isPowerOfTwo(int size) { return size > 0 && (size & (size - 1)) == 0; }
+
+unsigned int plannerFlags(fft::PlanningMode mode) {
+  switch (mode) {
+  case fft::PlanningMode::measure:
+    return FFTW_MEASURE;
+  case fft::PlanningMode::patient:
+    return FFTW_PATIENT;
+  default:
+    return FFTW_ESTIMATE;
+  }
+}
+
+/**
+ * Find a cached plan or create a new one
+ *
+ * @param key transform parameters
+ * @return shared plan
+ */
+shared_ptr<CachedPlan> getPlan(const PlanKey &key) {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+
+  if (const auto *found = planCache.get(key)) {
+    return *found;
+  }
+
+  // N complex values are enough to hold either N real samples
+  // or N/2+1 complex values of a half spectrum
+  const int bufferSize = max(key.size, fft::halfSpectrumSize(key.size));
+
+  // planning buffers are only used to pick the algorithm (and overwritten by
+  // measure and patient modes), execution uses per-thread buffers
+  auto in = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * bufferSize);
+  auto out = key.inPlace ? in
+                         : (fftw_complex *)fftw_malloc(sizeof(fftw_complex) *
+                                                       bufferSize);
+
+  auto plan = [&](unsigned int flags) {
+    switch (key.kind) {
+    case TransformKind::realToComplex:
+      return fftw_plan_dft_r2c_1d(key.size, reinterpret_cast<double *>(in),
+                                  out, flags);
+    case TransformKind::complexToReal:
+      return fftw_plan_dft_c2r_1d(key.size, in,
+                                  reinterpret_cast<double *>(out), flags);
+    default:
+      return fftw_plan_dft_1d(key.size, in, out, key.direction, flags);
+    }
+  };
+
+  auto cached = make_shared<CachedPlan>();
+  const unsigned int flags = plannerFlags(planningMode);
+  if (flags == FFTW_ESTIMATE || isPowerOfTwo(key.size)) {
+    cached->plan = plan(flags);
+  } else {
+    // measuring other sizes takes seconds, unless wisdom already has them
+    cached->plan = plan(flags | FFTW_WISDOM_ONLY);
+    if (cached->plan == nullptr) {
+      cached->plan = plan(FFTW_ESTIMATE);
+    }
+  }
+
+  if (out != in) {
+    fftw_free(out);
+  }
+  fftw_free(in);
+
+  planCache.put(key, cached);
+
+  return cached;
+}
+
+/**
+ * Find a plan in the current thread's cache, fall back to the shared one
+ *
+ * @param key transform parameters
+ * @return shared plan
+ */
+shared_ptr<CachedPlan> getThreadPlan(const PlanKey &key) {
+  const unsigned int generation = planCacheGeneration.load();
+  if (threadPlanCache.generation != generation) {
+    threadPlanCache.plans.clear();
+    threadPlanCache.generation = generation;
+  }
+
+  if (const auto *found = threadPlanCache.plans.get(key)) {
+    return *found;
+  }
+
+  auto plan = getPlan(key);
+  threadPlanCache.plans.put(key, plan);
+  return plan;
+}
+
+/**
+ * Execute cached plan copying input from and result to the given buffers
+ *
+ * @param key transform parameters
+ * @param input inputSize values of InputType (double or complex<double>)
+ * @param output outputSize values of OutputType (double or complex<double>)
+ */
+template <typename InputType, typename OutputType>
+void execute(const PlanKey &key, const InputType *input, int inputSize,
+             OutputType *output, int outputSize) {
+  // keep the plan alive even if the cache is cleared meanwhile
+  shared_ptr<CachedPlan> cached = getThreadPlan(key);
+
+  scratchBuffers.reserve(max(key.size, fft::halfSpectrumSize(key.size)));
+  fftw_complex *in = scratchBuffers.in;
+  fftw_complex *out = key.inPlace ? in : scratchBuffers.out;
+
+  copy(input, input + inputSize, reinterpret_cast<InputType *>(in));
+  switch (key.kind) {
+  case TransformKind::realToComplex:
+    fftw_execute_dft_r2c(cached->plan, reinterpret_cast<double *>(in), out);
+    break;
+  case TransformKind::complexToReal:
+    fftw_execute_dft_c2r(cached->plan, in, reinterpret_cast<double *>(out));
+    break;
+  default:
+    fftw_execute_dft(cached->plan, in, out);
+  }
+  auto result = reinterpret_cast<const OutputType *>(out);
+  copy(result, result + outputSize, output);
+}
+
+} // namespace
+
+/**
+ * Set FFTW planning mode for the newly created plans.
+ * Already cached plans are dropped, so that the next transforms are
+ * re-planned with the requested effort.
+ * Measure and patient modes apply to power of two sizes and to sizes found
+ * in the imported wisdom, other sizes are estimated.
+ *
+ * @param mode estimate (fast planning), measure or patient (slower planning,
+ * faster transforms)
+ */
+void fft::setPlanningMode(PlanningMode mode) {
+  {
+    lock_guard<recursive_mutex> lock(plannerMutex);
+    if (mode == planningMode) {
+      return;
+    }
+    planningMode = mode;
+  }
+  clearPlanCache();
+}
+
+fft::PlanningMode fft::getPlanningMode() {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+  return planningMode;
+}
+
+/**
+ * Load previously saved FFTW wisdom, so that measured plans are
+ * created without repeating the measurements
+ *
+ * @param path wisdom file path
+ * @return true if wisdom was successfully imported
+ */
+bool fft::importWisdom(const string &path) {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+  return fftw_import_wisdom_from_filename(path.c_str()) != 0;
+}
+
+/**
+ * Save accumulated FFTW wisdom to a file
+ *
+ * @param path wisdom file path
+ * @return true if wisdom was successfully exported
+ */
+bool fft::exportWisdom(const string &path) {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+  return fftw_export_wisdom_to_filename(path.c_str()) != 0;
+}
+
+/**
+ * Drop all cached plans. Plans used by in-flight transforms are destroyed
+ * once these transforms complete.
+ */
+void fft::clearPlanCache() {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+  planCache.clear();
+  planCacheGeneration++;
+}
+
+/**
+ * @return number of cached FFTW plans, the least recently used ones are
+ * dropped beyond planCacheMaxEntries
+ */
+size_t fft::planCacheSize() {
+  lock_guard<recursive_mutex> lock(plannerMutex);
+  return planCache.size();
+}
+
 /**
  * Perform direct or inverse Fast Fourier Transform
  *
@@ -13,43 +314,156 @@ using namespace std;
  */
 vector<complex<double>> fft::transform(const vector<complex<double>> &samples,
                                        bool direct) {
-  fftw_complex *in =
-      (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * samples.size());
-  fftw_complex *out =
-      (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * samples.size());
+  vector<complex<double>> result(samples.size());
+  if (samples.empty()) {
+    return result;
+  }
+
+  const int size = samples.size();
+  execute({TransformKind::complexToComplex, size,
+           direct ? FFTW_FORWARD : FFTW_BACKWARD, false},
+          samples.data(), size, result.data(), size);
 
-  int direction = direct ? FFTW_FORWARD : FFTW_BACKWARD;
-  fftw_plan p =
-      fftw_plan_dft_1d(samples.size(), in, out, direction, FFTW_ESTIMATE);
+  return result;
+}
 
-  // initialize the input
-  for (unsigned int i = 0; i < samples.size(); i++) {
-    in[i][0] = samples[i].real();
-    in[i][1] = samples[i].imag();
+/**
+ * Perform direct or inverse Fast Fourier Transform
+ * overwriting samples with the result
+ *
+ * @param samples complex values buffer to perform FFT on
+ * @param direct inverse or direct FFT
+ */
+void fft::transformInPlace(vector<complex<double>> &samples, bool direct) {
+  if (samples.empty()) {
+    return;
   }
 
-  fftw_execute(p);
+  const int size = samples.size();
+  execute({TransformKind::complexToComplex, size,
+           direct ? FFTW_FORWARD : FFTW_BACKWARD, true},
+          samples.data(), size, samples.data(), size);
+}
+
+vector<complex<double>> fft::direct(const vector<complex<double>> &samples) {
+  return fft::transform(samples, true);
+}
+
+vector<complex<double>> fft::inverse(const vector<complex<double>> &samples) {
+  return fft::transform(samples, false);
+}
+
+/**
+ * Number of non-redundant DFT values of a real signal.
+ * Spectrum of a real signal is Hermitian: X[N-k] = conj(X[k]).
+ *
+ * @param size real signal length N
+ * @return N/2+1
+ */
+int fft::halfSpectrumSize(int size) { return size / 2 + 1; }
 
+/**
+ * Perform direct Fast Fourier Transform of real samples
+ *
+ * @param samples real values buffer to perform FFT on
+ * @return first N/2+1 complex FFT values (half spectrum)
+ */
+vector<complex<double>> fft::directReal(const vector<double> &samples) {
   vector<complex<double>> result;
-  result.reserve(samples.size());
+  if (samples.empty()) {
+    return result;
+  }
 
-  for (unsigned int i = 0; i < samples.size(); i++) {
-    result.push_back(complex<double>(out[i][0], out[i][1]));
+  result.resize(halfSpectrumSize(samples.size()));
+  directReal(samples.data(), result.data(), samples.size());
+
+  return result;
+}
+
+/**
+ * Perform direct Fast Fourier Transform of real samples
+ * into a caller provided buffer, doesn't allocate if the plan is cached
+ *
+ * @param samples N real values to perform FFT on
+ * @param halfSpectrum buffer for N/2+1 complex FFT values
+ * @param size N
+ */
+void fft::directReal(const double *samples, complex<double> *halfSpectrum,
+                     int size) {
+  if (size < 1) {
+    return;
   }
 
-  fftw_destroy_plan(p);
-  fftw_free(in);
-  fftw_free(out);
+  execute({TransformKind::realToComplex, size, FFTW_FORWARD, false}, samples,
+          size, halfSpectrum, halfSpectrumSize(size));
+}
+
+/**
+ * Perform inverse Fast Fourier Transform of a Hermitian spectrum.
+ * Same as fft::inverse, result is not normalized.
+ *
+ * @param halfSpectrum first N/2+1 complex values of the spectrum
+ * @param size N, length of the restored real signal
+ * @return real restored samples
+ */
+vector<double> fft::inverseReal(const vector<complex<double>> &halfSpectrum,
+                                int size) {
+  if (size < 1) {
+    return {};
+  }
+  if (static_cast<int>(halfSpectrum.size()) != halfSpectrumSize(size)) {
+    throw invalid_argument("inverseReal: halfSpectrum must have size/2+1 "
+                           "elements");
+  }
+
+  vector<double> result(size);
+  inverseReal(halfSpectrum.data(), result.data(), size);
 
   return result;
 }
 
-vector<complex<double>> fft::direct(const vector<complex<double>> &samples) {
-  return fft::transform(samples, true);
+/**
+ * Perform inverse Fast Fourier Transform of a Hermitian spectrum
+ * into a caller provided buffer, doesn't allocate if the plan is cached
+ *
+ * @param halfSpectrum first N/2+1 complex values of the spectrum
+ * @param samples buffer for N real restored (not normalized) values
+ * @param size N
+ */
+void fft::inverseReal(const complex<double> *halfSpectrum, double *samples,
+                      int size) {
+  if (size < 1) {
+    return;
+  }
+
+  execute({TransformKind::complexToReal, size, FFTW_BACKWARD, false},
+          halfSpectrum, halfSpectrumSize(size), samples, size);
 }
 
-vector<complex<double>> fft::inverse(const vector<complex<double>> &samples) {
-  return fft::transform(samples, false);
+/**
+ * Restore full N-points spectrum of a real signal from it's half spectrum
+ *
+ * @param halfSpectrum first N/2+1 complex values of the spectrum
+ * @param size N, full spectrum length
+ * @return full spectrum X[0..N)
+ */
+vector<complex<double>>
+fft::toFullSpectrum(const vector<complex<double>> &halfSpectrum, int size) {
+  if (size < 1) {
+    return {};
+  }
+  if (static_cast<int>(halfSpectrum.size()) != halfSpectrumSize(size)) {
+    throw invalid_argument("toFullSpectrum: halfSpectrum must have size/2+1 "
+                           "elements");
+  }
+
+  vector<complex<double>> result(size);
+  copy(halfSpectrum.begin(), halfSpectrum.end(), result.begin());
+  for (int i = halfSpectrum.size(); i < size; i++) {
+    result[i] = conj(halfSpectrum[size - i]);
+  }
+
+  return result;
 }
 
 /**
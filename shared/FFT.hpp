@@ -3,21 +3,51 @@
 
 #include "fftw3.h"
 #include <complex>
+#include <string>
 #include <vector>
 
 namespace fft {
 
+/**
+ * FFTW planner effort used when a plan for a new transform size is created.
+ * Plans are cached, so a slower planning mode is paid once per size.
+ * Sizes other than powers of two are only measured if wisdom has them.
+ */
+enum class PlanningMode { estimate, measure, patient };
+
+void setPlanningMode(PlanningMode mode);
+PlanningMode getPlanningMode();
+
+bool importWisdom(const std::string &path);
+bool exportWisdom(const std::string &path);
+
+void clearPlanCache();
+size_t planCacheSize();
+
 std::vector<std::complex<double>>
 toComplexVector(const std::vector<double> &samples);
 
 std::vector<std::complex<double>>
 transform(const std::vector<std::complex<double>> &samples, bool direct = true);
+void transformInPlace(std::vector<std::complex<double>> &samples,
+                      bool direct = true);
 
 std::vector<std::complex<double>>
 direct(const std::vector<std::complex<double>> &samples);
 std::vector<std::complex<double>>
 inverse(const std::vector<std::complex<double>> &samples);
 
+int halfSpectrumSize(int size);
+std::vector<std::complex<double>> directReal(const std::vector<double> &samples);
+std::vector<double>
+inverseReal(const std::vector<std::complex<double>> &halfSpectrum, int size);
+void directReal(const double *samples, std::complex<double> *halfSpectrum,
+                int size);
+void inverseReal(const std::complex<double> *halfSpectrum, double *samples,
+                 int size);
+std::vector<std::complex<double>>
+toFullSpectrum(const std::vector<std::complex<double>> &halfSpectrum, int size);
+
 } // namespace fft
 
 #endif
@@ -3,6 +3,8 @@
 
 #include <vector>
 #include "FilterResponse.hpp"
+#include "FrequencyResponse.hpp"
+#include "FrequencyGrid.hpp"
 
 class Filter {
 public:
@@ -12,6 +14,10 @@ public:
   virtual int getSamplingRate() const = 0;
   virtual std::vector<double> getFilterCoefficients() const = 0;
   virtual std::vector<FilterResponse> calculateResponse() const = 0;
+  virtual std::vector<FilterResponse>
+  calculateResponse(const FrequencyGrid &grid) const = 0;
+  virtual FrequencyResponse<>
+  calculateFrequencyResponse(const FrequencyGrid &grid) const = 0;
 };
 
 #endif
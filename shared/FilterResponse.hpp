@@ -5,8 +5,8 @@
 #include <vector>
 
 struct FilterResponse {
-  const double magnitudeDB;
-  const double phaseShift;
+  double magnitudeDB;
+  double phaseShift;
 
   FilterResponse(double m, double p) : magnitudeDB{m}, phaseShift{p} {}
 };
@@ -0,0 +1,97 @@
+#include "FrequencyGrid.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+FrequencyGrid::FrequencyGrid(vector<double> frequencies, double step)
+    : frequencies{std::move(frequencies)}, step{step} {}
+
+/**
+ * Evenly spaced frequencies including both range ends
+ *
+ * @param fromFrequency first frequency (Hz)
+ * @param toFrequency last frequency (Hz)
+ * @param pointsCount number of frequencies
+ * @return uniform frequency grid
+ */
+FrequencyGrid FrequencyGrid::linear(double fromFrequency, double toFrequency,
+                                    int pointsCount) {
+  if (pointsCount < 1) {
+    throw invalid_argument("FrequencyGrid: pointsCount must be >= 1");
+  }
+  if (toFrequency < fromFrequency) {
+    throw invalid_argument("FrequencyGrid: toFrequency must be >= "
+                           "fromFrequency");
+  }
+
+  const double step =
+      pointsCount > 1 ? (toFrequency - fromFrequency) / (pointsCount - 1) : 0;
+
+  vector<double> frequencies;
+  frequencies.reserve(pointsCount);
+  for (int i = 0; i < pointsCount; i++) {
+    frequencies.push_back(fromFrequency + i * step);
+  }
+
+  return FrequencyGrid(std::move(frequencies), step);
+}
+
+/**
+ * Logarithmically spaced frequencies including both range ends.
+ * Gives fine resolution at low frequencies for log-scale plots.
+ *
+ * @param fromFrequency first frequency (Hz), must be > 0
+ * @param toFrequency last frequency (Hz)
+ * @param pointsCount number of frequencies
+ * @return logarithmic frequency grid
+ */
+FrequencyGrid FrequencyGrid::logarithmic(double fromFrequency,
+                                         double toFrequency, int pointsCount) {
+  if (pointsCount < 1) {
+    throw invalid_argument("FrequencyGrid: pointsCount must be >= 1");
+  }
+  if (fromFrequency <= 0) {
+    throw invalid_argument("FrequencyGrid: fromFrequency must be > 0");
+  }
+  if (toFrequency < fromFrequency) {
+    throw invalid_argument("FrequencyGrid: toFrequency must be >= "
+                           "fromFrequency");
+  }
+
+  const double ratio =
+      pointsCount > 1 ? pow(toFrequency / fromFrequency, 1.0 / (pointsCount - 1))
+                      : 1;
+
+  vector<double> frequencies;
+  frequencies.reserve(pointsCount);
+  for (int i = 0; i < pointsCount; i++) {
+    frequencies.push_back(fromFrequency * pow(ratio, i));
+  }
+  if (pointsCount > 1) {
+    frequencies.back() = toFrequency;
+  }
+
+  return FrequencyGrid(std::move(frequencies), 0);
+}
+
+/**
+ * Explicit list of frequencies
+ *
+ * @param frequencies frequencies (Hz) in any order
+ * @return frequency grid
+ */
+FrequencyGrid FrequencyGrid::list(const vector<double> &frequencies) {
+  return FrequencyGrid(frequencies, 0);
+}
+
+const vector<double> &FrequencyGrid::getFrequencies() const {
+  return frequencies;
+}
+
+int FrequencyGrid::size() const { return frequencies.size(); }
+
+bool FrequencyGrid::isUniform() const { return step > 0; }
+
+double FrequencyGrid::getStep() const { return step; }
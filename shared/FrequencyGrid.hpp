@@ -0,0 +1,31 @@
+#ifndef FREQUENCYGRID_HPP
+#define FREQUENCYGRID_HPP
+
+#include <vector>
+
+/**
+ * Set of frequencies (Hz) to evaluate filter response at
+ */
+class FrequencyGrid {
+public:
+  static FrequencyGrid linear(double fromFrequency, double toFrequency,
+                              int pointsCount);
+  static FrequencyGrid logarithmic(double fromFrequency, double toFrequency,
+                                   int pointsCount);
+  static FrequencyGrid list(const std::vector<double> &frequencies);
+
+  const std::vector<double> &getFrequencies() const;
+  int size() const;
+
+  bool isUniform() const;
+  double getStep() const;
+
+private:
+  FrequencyGrid(std::vector<double> frequencies, double step);
+
+  std::vector<double> frequencies;
+  // distance between neighbour frequencies for a uniform grid, 0 otherwise
+  double step;
+};
+
+#endif // FREQUENCYGRID_HPP
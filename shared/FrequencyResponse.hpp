@@ -0,0 +1,111 @@
+#ifndef FREQUENCYRESPONSE_HPP
+#define FREQUENCYRESPONSE_HPP
+
+#include "FilterResponse.hpp"
+#include "Phase.hpp"
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Filter response stored as contiguous frequency, magnitude and phase arrays.
+ *
+ * Consumers mostly need one quantity at a time (a chart series, a min/max
+ * scan), so arrays are kept separately instead of as FilterResponse pairs.
+ * FrequencyResponse<float> halves the memory of responses kept around,
+ * e.g. for comparison, at about 7 significant digits.
+ */
+template <typename T = double> class FrequencyResponse {
+public:
+  using value_type = T;
+
+  FrequencyResponse() = default;
+
+  /**
+   * @param frequencies response frequencies (Hz)
+   * @param magnitudesDB magnitudes (dB) for each frequency
+   * @param phaseShifts phase shifts (radians) for each frequency
+   */
+  FrequencyResponse(std::vector<T> frequencies, std::vector<T> magnitudesDB,
+                    std::vector<T> phaseShifts)
+      : frequencies{std::move(frequencies)},
+        magnitudesDB{std::move(magnitudesDB)},
+        phaseShifts{std::move(phaseShifts)} {
+    if (this->frequencies.size() != this->magnitudesDB.size() ||
+        this->frequencies.size() != this->phaseShifts.size()) {
+      throw std::invalid_argument(
+          "FrequencyResponse: arrays must be of the same size");
+    }
+  }
+
+  /**
+   * Convert between storage types, e.g. double to float
+   */
+  template <typename U>
+  explicit FrequencyResponse(const FrequencyResponse<U> &other)
+      : frequencies(other.getFrequencies().begin(),
+                    other.getFrequencies().end()),
+        magnitudesDB(other.getMagnitudesDB().begin(),
+                     other.getMagnitudesDB().end()),
+        phaseShifts(other.getPhaseShifts().begin(),
+                    other.getPhaseShifts().end()) {}
+
+  int size() const { return frequencies.size(); }
+  bool empty() const { return frequencies.empty(); }
+
+  void reserve(int size) {
+    frequencies.reserve(size);
+    magnitudesDB.reserve(size);
+    phaseShifts.reserve(size);
+  }
+
+  void push_back(T frequency, T magnitudeDB, T phaseShift) {
+    frequencies.push_back(frequency);
+    magnitudesDB.push_back(magnitudeDB);
+    phaseShifts.push_back(phaseShift);
+  }
+
+  std::span<const T> getFrequencies() const { return frequencies; }
+  std::span<const T> getMagnitudesDB() const { return magnitudesDB; }
+  std::span<const T> getPhaseShifts() const { return phaseShifts; }
+
+  std::span<T> getFrequencies() { return frequencies; }
+  std::span<T> getMagnitudesDB() { return magnitudesDB; }
+  std::span<T> getPhaseShifts() { return phaseShifts; }
+
+  FilterResponse operator[](int i) const {
+    return FilterResponse(magnitudesDB[i], phaseShifts[i]);
+  }
+
+  /**
+   * Remove phase jumps greater than Pi in place
+   */
+  void unwrapPhaseShifts() {
+    if (phaseShifts.empty()) {
+      return;
+    }
+    const auto unwrapped = phaseUnwrap(
+        std::vector<double>(phaseShifts.begin(), phaseShifts.end()));
+    std::copy(unwrapped.begin(), unwrapped.end(), phaseShifts.begin());
+  }
+
+  /**
+   * @return magnitudes and phase shifts as FilterResponse pairs
+   */
+  std::vector<FilterResponse> toFilterResponses() const {
+    std::vector<FilterResponse> response;
+    response.reserve(frequencies.size());
+    for (unsigned int i = 0; i < frequencies.size(); i++) {
+      response.push_back(FilterResponse(magnitudesDB[i], phaseShifts[i]));
+    }
+    return response;
+  }
+
+private:
+  std::vector<T> frequencies;
+  std::vector<T> magnitudesDB;
+  std::vector<T> phaseShifts;
+};
+
+#endif // FREQUENCYRESPONSE_HPP
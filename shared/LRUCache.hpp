@@ -0,0 +1,123 @@
+#ifndef LRUCACHE_HPP
+#define LRUCACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Least recently used cache bounded by the number of entries and by the total
+ * cost (e.g. memory size in bytes) of the values.
+ * Not thread-safe.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+  /**
+   * @param maxEntries maximum number of cached values
+   * @param maxCost maximum total cost of cached values
+   */
+  LRUCache(int maxEntries, std::size_t maxCost) {
+    setLimits(maxEntries, maxCost);
+  }
+
+  /**
+   * Find value and mark it as the most recently used one
+   *
+   * @return cached value or nullptr, valid until the cache is modified
+   */
+  const Value *get(const Key &key) {
+    auto found = index.find(key);
+    if (found == index.end()) {
+      misses++;
+      return nullptr;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    return &found->second->value;
+  }
+
+  bool contains(const Key &key) const { return index.contains(key); }
+
+  /**
+   * Add or replace value, evicting the least recently used values
+   * to stay within the limits. Values costing more than maxCost are not
+   * cached.
+   *
+   * @param cost value cost in the same units as maxCost
+   */
+  void put(const Key &key, Value value, std::size_t cost = 1) {
+    remove(key);
+    if (cost > maxCost) {
+      return;
+    }
+    entries.push_front({key, std::move(value), cost});
+    index.emplace(key, entries.begin());
+    totalCost += cost;
+    evict();
+  }
+
+  void remove(const Key &key) {
+    auto found = index.find(key);
+    if (found == index.end()) {
+      return;
+    }
+    totalCost -= found->second->cost;
+    entries.erase(found->second);
+    index.erase(found);
+  }
+
+  void clear() {
+    entries.clear();
+    index.clear();
+    totalCost = 0;
+  }
+
+  void setLimits(int maxEntries, std::size_t maxCost) {
+    if (maxEntries < 1) {
+      throw std::invalid_argument("LRUCache: maxEntries must be >= 1");
+    }
+    this->maxEntries = maxEntries;
+    this->maxCost = maxCost;
+    evict();
+  }
+
+  int size() const { return entries.size(); }
+  std::size_t getCost() const { return totalCost; }
+  int getMaxEntries() const { return maxEntries; }
+  std::size_t getMaxCost() const { return maxCost; }
+
+  long getHitsCount() const { return hits; }
+  long getMissesCount() const { return misses; }
+
+private:
+  struct Entry {
+    Key key;
+    Value value;
+    std::size_t cost;
+  };
+
+  // most recently used first
+  std::list<Entry> entries;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+
+  int maxEntries;
+  std::size_t maxCost;
+  std::size_t totalCost = 0;
+  long hits = 0;
+  long misses = 0;
+
+  void evict() {
+    while (!entries.empty() && (static_cast<int>(entries.size()) > maxEntries ||
+                                totalCost > maxCost)) {
+      totalCost -= entries.back().cost;
+      index.erase(entries.back().key);
+      entries.pop_back();
+    }
+  }
+};
+
+#endif // LRUCACHE_HPP
@@ -0,0 +1,258 @@
+#include "ProgressiveResponse.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+// -Inf dB nulls are treated as this level when comparing neighbours
+constexpr double magnitudeFloorDB = -300;
+// radians of phase change counted as much as one dB of magnitude change
+constexpr double phaseWeight = 20 / numbers::pi;
+
+double clampMagnitude(double magnitudeDB) {
+  return isnan(magnitudeDB) ? magnitudeFloorDB
+                            : max(magnitudeDB, magnitudeFloorDB);
+}
+
+/**
+ * @return phase difference wrapped to [-pi, pi]
+ */
+double phaseDistance(double from, double to) {
+  return remainder(to - from, 2 * numbers::pi);
+}
+
+} // namespace
+
+/**
+ * Calculate coarse filter response.
+ *
+ * @param filter filter to calculate the response of, must outlive this object
+ * @param fromFrequency first frequency (Hz)
+ * @param toFrequency last frequency (Hz), rounded down to the resolution grid
+ * @param resolution distance between frequencies of the complete response
+ * @param initialPointsCount number of evenly spaced frequencies to start with
+ */
+ProgressiveResponse::ProgressiveResponse(const Filter &filter,
+                                         double fromFrequency,
+                                         double toFrequency, double resolution,
+                                         int initialPointsCount)
+    : filter{filter}, fromFrequency{fromFrequency}, resolution{resolution} {
+  if (resolution <= 0) {
+    throw invalid_argument("ProgressiveResponse: resolution must be > 0");
+  }
+  if (toFrequency < fromFrequency) {
+    throw invalid_argument(
+        "ProgressiveResponse: toFrequency must be >= fromFrequency");
+  }
+  if (initialPointsCount < 2) {
+    throw invalid_argument(
+        "ProgressiveResponse: initialPointsCount must be >= 2");
+  }
+
+  const int lastStep = floor((toFrequency - fromFrequency) / resolution);
+  const int pointsCount = min(initialPointsCount, lastStep + 1);
+
+  vector<int> initialSteps;
+  for (int i = 0; i < pointsCount; i++) {
+    const int step =
+        pointsCount > 1 ? round(static_cast<double>(i) * lastStep /
+                                (pointsCount - 1))
+                        : 0;
+    if (initialSteps.empty() || step != initialSteps.back()) {
+      initialSteps.push_back(step);
+    }
+  }
+
+  vector<double> frequencies;
+  for (int step : initialSteps) {
+    frequencies.push_back(getFrequency(step));
+  }
+  merge(initialSteps,
+        filter.calculateFrequencyResponse(FrequencyGrid::list(frequencies)));
+}
+
+double ProgressiveResponse::getFrequency(int step) const {
+  return fromFrequency + step * resolution;
+}
+
+/**
+ * How fast response changes within the interval between steps[interval] and
+ * steps[interval+1]: magnitude change, plus magnitude and phase curvature at
+ * both ends to catch lobe peaks which may fall between two equal values.
+ * Linear phase (constant group delay) has no curvature and doesn't need
+ * refinement.
+ */
+double ProgressiveResponse::getIntervalScore(int interval) const {
+  const double left = clampMagnitude(magnitudesDB[interval]);
+  const double right = clampMagnitude(magnitudesDB[interval + 1]);
+  const double phaseStep =
+      phaseDistance(phaseShifts[interval], phaseShifts[interval + 1]);
+
+  double score = abs(right - left);
+
+  if (interval > 0) {
+    const double previous = clampMagnitude(magnitudesDB[interval - 1]);
+    score += abs(previous - 2 * left + right);
+    score += phaseWeight *
+             abs(phaseDistance(
+                 phaseDistance(phaseShifts[interval - 1], phaseShifts[interval]),
+                 phaseStep));
+  }
+  if (interval + 2 < static_cast<int>(steps.size())) {
+    const double next = clampMagnitude(magnitudesDB[interval + 2]);
+    score += abs(left - 2 * right + next);
+    score += phaseWeight *
+             abs(phaseDistance(phaseStep,
+                               phaseDistance(phaseShifts[interval + 1],
+                                             phaseShifts[interval + 2])));
+  }
+
+  return score;
+}
+
+/**
+ * Add up to maxPointsCount frequencies in the middle of intervals where
+ * response changes fastest. Among equally changing intervals the widest are
+ * refined first.
+ *
+ * @param maxPointsCount max number of frequencies to calculate
+ * @return number of added frequencies, 0 if response is complete
+ */
+int ProgressiveResponse::refine(int maxPointsCount) {
+  vector<int> intervals;
+  vector<double> scores;
+  for (int i = 0; i + 1 < static_cast<int>(steps.size()); i++) {
+    if (steps[i + 1] - steps[i] > 1) {
+      intervals.push_back(i);
+    }
+  }
+  if (intervals.empty() || maxPointsCount < 1) {
+    return 0;
+  }
+
+  scores.resize(steps.size());
+  for (int i : intervals) {
+    scores[i] = getIntervalScore(i);
+  }
+
+  const int count = min(maxPointsCount, static_cast<int>(intervals.size()));
+  partial_sort(intervals.begin(), intervals.begin() + count, intervals.end(),
+               [&](int a, int b) {
+                 if (scores[a] != scores[b]) {
+                   return scores[a] > scores[b];
+                 }
+                 return steps[a + 1] - steps[a] > steps[b + 1] - steps[b];
+               });
+  intervals.resize(count);
+  sort(intervals.begin(), intervals.end());
+
+  vector<int> newSteps;
+  vector<double> frequencies;
+  for (int i : intervals) {
+    const int step = (steps[i] + steps[i + 1]) / 2;
+    newSteps.push_back(step);
+    frequencies.push_back(getFrequency(step));
+  }
+
+  auto response =
+      filter.calculateFrequencyResponse(FrequencyGrid::list(frequencies));
+  merge(newSteps, response);
+
+  return newSteps.size();
+}
+
+/**
+ * Insert calculated response values keeping frequencies sorted
+ */
+void ProgressiveResponse::merge(const vector<int> &newSteps,
+                                const FrequencyResponse<> &response) {
+  const auto responseMagnitudes = response.getMagnitudesDB();
+  const auto responsePhases = response.getPhaseShifts();
+
+  vector<int> mergedSteps;
+  vector<double> mergedMagnitudes;
+  vector<double> mergedPhases;
+  const int mergedSize = steps.size() + newSteps.size();
+  mergedSteps.reserve(mergedSize);
+  mergedMagnitudes.reserve(mergedSize);
+  mergedPhases.reserve(mergedSize);
+
+  unsigned int i = 0;
+  unsigned int j = 0;
+  while (i < steps.size() || j < newSteps.size()) {
+    if (j == newSteps.size() ||
+        (i < steps.size() && steps[i] < newSteps[j])) {
+      mergedSteps.push_back(steps[i]);
+      mergedMagnitudes.push_back(magnitudesDB[i]);
+      mergedPhases.push_back(phaseShifts[i]);
+      i++;
+    } else {
+      mergedSteps.push_back(newSteps[j]);
+      mergedMagnitudes.push_back(responseMagnitudes[j]);
+      mergedPhases.push_back(responsePhases[j]);
+      j++;
+    }
+  }
+
+  steps = std::move(mergedSteps);
+  magnitudesDB = std::move(mergedMagnitudes);
+  phaseShifts = std::move(mergedPhases);
+}
+
+/**
+ * @return true if response is calculated at every frequency of the
+ * resolution grid
+ */
+bool ProgressiveResponse::isComplete() const {
+  for (unsigned int i = 1; i < steps.size(); i++) {
+    if (steps[i] - steps[i - 1] > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int ProgressiveResponse::size() const { return steps.size(); }
+
+/**
+ * @return calculated frequencies in ascending order
+ */
+vector<double> ProgressiveResponse::getFrequencies() const {
+  vector<double> frequencies;
+  frequencies.reserve(steps.size());
+  for (int step : steps) {
+    frequencies.push_back(getFrequency(step));
+  }
+  return frequencies;
+}
+
+const vector<double> &ProgressiveResponse::getMagnitudesDB() const {
+  return magnitudesDB;
+}
+
+const vector<double> &ProgressiveResponse::getPhaseShifts() const {
+  return phaseShifts;
+}
+
+/**
+ * @return calculated frequencies with their magnitudes and phase shifts
+ */
+FrequencyResponse<> ProgressiveResponse::getFrequencyResponse() const {
+  return FrequencyResponse<>(getFrequencies(), magnitudesDB, phaseShifts);
+}
+
+/**
+ * @return magnitudes and phase shifts for each of getFrequencies()
+ */
+vector<FilterResponse> ProgressiveResponse::getResponse() const {
+  vector<FilterResponse> response;
+  response.reserve(steps.size());
+  for (unsigned int i = 0; i < steps.size(); i++) {
+    response.push_back(FilterResponse(magnitudesDB[i], phaseShifts[i]));
+  }
+  return response;
+}
@@ -0,0 +1,50 @@
+#ifndef PROGRESSIVE_RESPONSE_H
+#define PROGRESSIVE_RESPONSE_H
+
+#include "Filter.hpp"
+#include "FilterResponse.hpp"
+#include "FrequencyResponse.hpp"
+#include <vector>
+
+/**
+ * Filter response calculated coarse-to-fine.
+ * Starts with a few evenly spaced frequencies, then each refine() call adds
+ * frequencies where the response changes fastest, until every frequency of
+ * the from + k * resolution grid is calculated.
+ */
+class ProgressiveResponse {
+public:
+  static constexpr int defaultInitialPointsCount = 256;
+
+  ProgressiveResponse(const Filter &filter, double fromFrequency,
+                      double toFrequency, double resolution = 1,
+                      int initialPointsCount = defaultInitialPointsCount);
+
+  int refine(int maxPointsCount);
+  bool isComplete() const;
+
+  int size() const;
+  std::vector<double> getFrequencies() const;
+  const std::vector<double> &getMagnitudesDB() const;
+  const std::vector<double> &getPhaseShifts() const;
+  std::vector<FilterResponse> getResponse() const;
+  FrequencyResponse<> getFrequencyResponse() const;
+
+private:
+  const Filter &filter;
+  const double fromFrequency;
+  const double resolution;
+
+  // calculated frequencies are fromFrequency + steps[i] * resolution,
+  // steps are sorted
+  std::vector<int> steps;
+  std::vector<double> magnitudesDB;
+  std::vector<double> phaseShifts;
+
+  double getFrequency(int step) const;
+  double getIntervalScore(int interval) const;
+  void merge(const std::vector<int> &newSteps,
+             const FrequencyResponse<> &response);
+};
+
+#endif
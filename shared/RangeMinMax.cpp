@@ -0,0 +1,97 @@
+#include "RangeMinMax.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Build sparse tables of range minimums and maximums, O(n log n).
+ * Non-finite values (e.g. -inf dB magnitudes of zeros) are ignored.
+ *
+ * @param values values to query
+ */
+RangeMinMax::RangeMinMax(span<const double> values) {
+  const int valuesCount = values.size();
+  if (valuesCount == 0) {
+    return;
+  }
+
+  vector<double> levelMinimums(valuesCount);
+  vector<double> levelMaximums(valuesCount);
+  for (int i = 0; i < valuesCount; i++) {
+    const bool finite = isfinite(values[i]);
+    levelMinimums[i] = finite ? values[i] : INFINITY;
+    levelMaximums[i] = finite ? values[i] : -INFINITY;
+  }
+  minimums.push_back(std::move(levelMinimums));
+  maximums.push_back(std::move(levelMaximums));
+
+  for (int width = 1; 2 * width <= valuesCount; width *= 2) {
+    const auto &previousMinimums = minimums.back();
+    const auto &previousMaximums = maximums.back();
+    const int count = valuesCount - 2 * width + 1;
+
+    levelMinimums.resize(count);
+    levelMaximums.resize(count);
+    for (int i = 0; i < count; i++) {
+      levelMinimums[i] = min(previousMinimums[i], previousMinimums[i + width]);
+      levelMaximums[i] = max(previousMaximums[i], previousMaximums[i + width]);
+    }
+    minimums.push_back(std::move(levelMinimums));
+    maximums.push_back(std::move(levelMaximums));
+    levelMinimums = {};
+    levelMaximums = {};
+  }
+}
+
+int RangeMinMax::size() const {
+  return minimums.empty() ? 0 : minimums[0].size();
+}
+
+/**
+ * @return approximate size of the tables in bytes
+ */
+size_t RangeMinMax::getMemorySize() const {
+  size_t valuesCount = 0;
+  for (const auto &levelMinimums : minimums) {
+    valuesCount += levelMinimums.size();
+  }
+  return 2 * valuesCount * sizeof(double);
+}
+
+/**
+ * Minimum finite value of [from, to) range, O(1)
+ *
+ * @return +inf for an empty range or if there are no finite values
+ */
+double RangeMinMax::getMin(int from, int to) const {
+  if (from < 0 || to > size()) {
+    throw invalid_argument("RangeMinMax: range is out of bounds");
+  }
+  if (from >= to) {
+    return INFINITY;
+  }
+  // two overlapping power of two ranges cover [from, to)
+  const int level = bit_width(static_cast<unsigned int>(to - from)) - 1;
+  const auto &levelMinimums = minimums[level];
+  return min(levelMinimums[from], levelMinimums[to - (1 << level)]);
+}
+
+/**
+ * Maximum finite value of [from, to) range, O(1)
+ *
+ * @return -inf for an empty range or if there are no finite values
+ */
+double RangeMinMax::getMax(int from, int to) const {
+  if (from < 0 || to > size()) {
+    throw invalid_argument("RangeMinMax: range is out of bounds");
+  }
+  if (from >= to) {
+    return -INFINITY;
+  }
+  const int level = bit_width(static_cast<unsigned int>(to - from)) - 1;
+  const auto &levelMaximums = maximums[level];
+  return max(levelMaximums[from], levelMaximums[to - (1 << level)]);
+}
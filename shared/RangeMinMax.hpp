@@ -0,0 +1,27 @@
+#ifndef RANGEMINMAX_HPP
+#define RANGEMINMAX_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * Minimum and maximum of any subrange of values in constant time
+ */
+class RangeMinMax {
+public:
+  RangeMinMax() = default;
+  explicit RangeMinMax(std::span<const double> values);
+
+  double getMin(int from, int to) const;
+  double getMax(int from, int to) const;
+  int size() const;
+  std::size_t getMemorySize() const;
+
+private:
+  // minimums and maximums of 2^level values starting at each index
+  std::vector<std::vector<double>> minimums;
+  std::vector<std::vector<double>> maximums;
+};
+
+#endif // RANGEMINMAX_HPP
@@ -0,0 +1,627 @@
+#include "SIMD.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/*
+ * Scalar kernels, used as a fallback and to process vector tails
+ */
+
+template <typename T> T dotProductScalar(const T *a, const T *b, int count) {
+  T result = 0;
+  for (int i = 0; i < count; i++) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
+
+/**
+ * Linear phase filters have symmetric coefficients c[k] = c[count-1-k],
+ * so samples sharing a coefficient are added before the multiplication
+ * halving the number of multiplications
+ */
+template <typename T>
+T symmetricDotProductScalar(const T *coefficients, const T *samples, int count,
+                            int from = 0) {
+  T result = 0;
+  for (int i = from; i < count / 2; i++) {
+    result += coefficients[i] * (samples[i] + samples[count - 1 - i]);
+  }
+  if (count % 2 == 1) {
+    result += coefficients[count / 2] * samples[count / 2];
+  }
+  return result;
+}
+
+/**
+ * Multiply coefficients with every channel of interleaved frames:
+ * output[ch] = sum(c[k] * frames[k * channels + ch])
+ */
+template <typename T>
+void interleavedDotProductScalar(const T *coefficients, int count,
+                                 const T *frames, int channels, T *output,
+                                 int fromChannel = 0) {
+  for (int ch = fromChannel; ch < channels; ch++) {
+    output[ch] = 0;
+  }
+  for (int k = 0; k < count; k++) {
+    const T c = coefficients[k];
+    const T *frame = frames + k * channels;
+    for (int ch = fromChannel; ch < channels; ch++) {
+      output[ch] += c * frame[ch];
+    }
+  }
+}
+
+#ifdef SIMD_X86
+
+/*
+ * AVX2 kernels, 4 doubles or 8 floats per register
+ */
+
+__attribute__((target("avx2,fma"))) double horizontalSum(__m256d v) {
+  __m128d sum =
+      _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+__attribute__((target("avx2,fma"))) float horizontalSum(__m256 v) {
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2,fma"))) double
+dotProductAVX2(const double *a, const double *b, int count) {
+  __m256d sum0 = _mm256_setzero_pd();
+  __m256d sum1 = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i),
+                           sum0);
+    sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4),
+                           _mm256_loadu_pd(b + i + 4), sum1);
+  }
+  for (; i + 4 <= count; i += 4) {
+    sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i),
+                           sum0);
+  }
+  return horizontalSum(_mm256_add_pd(sum0, sum1)) +
+         dotProductScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) float
+dotProductAVX2(const float *a, const float *b, int count) {
+  __m256 sum0 = _mm256_setzero_ps();
+  __m256 sum1 = _mm256_setzero_ps();
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+                           sum0);
+    sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8),
+                           _mm256_loadu_ps(b + i + 8), sum1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+                           sum0);
+  }
+  return horizontalSum(_mm256_add_ps(sum0, sum1)) +
+         dotProductScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) double
+symmetricDotProductAVX2(const double *coefficients, const double *samples,
+                        int count) {
+  __m256d sum = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 4 <= count / 2; i += 4) {
+    const __m256d front = _mm256_loadu_pd(samples + i);
+    // samples[count-1-i .. count-4-i]
+    const __m256d back = _mm256_permute4x64_pd(
+        _mm256_loadu_pd(samples + count - 4 - i), _MM_SHUFFLE(0, 1, 2, 3));
+    sum = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients + i),
+                          _mm256_add_pd(front, back), sum);
+  }
+  return horizontalSum(sum) +
+         symmetricDotProductScalar(coefficients, samples, count, i);
+}
+
+__attribute__((target("avx2,fma"))) float
+symmetricDotProductAVX2(const float *coefficients, const float *samples,
+                        int count) {
+  const __m256i reverse = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256 sum = _mm256_setzero_ps();
+  int i = 0;
+  for (; i + 8 <= count / 2; i += 8) {
+    const __m256 front = _mm256_loadu_ps(samples + i);
+    const __m256 back = _mm256_permutevar8x32_ps(
+        _mm256_loadu_ps(samples + count - 8 - i), reverse);
+    sum = _mm256_fmadd_ps(_mm256_loadu_ps(coefficients + i),
+                          _mm256_add_ps(front, back), sum);
+  }
+  return horizontalSum(sum) +
+         symmetricDotProductScalar(coefficients, samples, count, i);
+}
+
+__attribute__((target("avx2,fma"))) void
+interleavedDotProductAVX2(const double *coefficients, int count,
+                          const double *frames, int channels, double *output) {
+  int ch = 0;
+  for (; ch + 4 <= channels; ch += 4) {
+    __m256d sum = _mm256_setzero_pd();
+    for (int k = 0; k < count; k++) {
+      sum = _mm256_fmadd_pd(_mm256_set1_pd(coefficients[k]),
+                            _mm256_loadu_pd(frames + k * channels + ch), sum);
+    }
+    _mm256_storeu_pd(output + ch, sum);
+  }
+  interleavedDotProductScalar(coefficients, count, frames, channels, output,
+                              ch);
+}
+
+__attribute__((target("avx2,fma"))) void
+interleavedDotProductAVX2(const float *coefficients, int count,
+                          const float *frames, int channels, float *output) {
+  int ch = 0;
+  for (; ch + 8 <= channels; ch += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    for (int k = 0; k < count; k++) {
+      sum = _mm256_fmadd_ps(_mm256_set1_ps(coefficients[k]),
+                            _mm256_loadu_ps(frames + k * channels + ch), sum);
+    }
+    _mm256_storeu_ps(output + ch, sum);
+  }
+  interleavedDotProductScalar(coefficients, count, frames, channels, output,
+                              ch);
+}
+
+/*
+ * AVX-512 kernels, 8 doubles or 16 floats per register
+ */
+
+// GCC's own AVX-512 intrinsics pass undefined registers to the builtins,
+// clang doesn't know -Wmaybe-uninitialized and would fail on it
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) double
+dotProductAVX512(const double *a, const double *b, int count) {
+  __m512d sum0 = _mm512_setzero_pd();
+  __m512d sum1 = _mm512_setzero_pd();
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i),
+                           sum0);
+    sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8),
+                           _mm512_loadu_pd(b + i + 8), sum1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i),
+                           sum0);
+  }
+  return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1)) +
+         dotProductScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx512f"))) float
+dotProductAVX512(const float *a, const float *b, int count) {
+  __m512 sum0 = _mm512_setzero_ps();
+  __m512 sum1 = _mm512_setzero_ps();
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+                           sum0);
+    sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16),
+                           _mm512_loadu_ps(b + i + 16), sum1);
+  }
+  for (; i + 16 <= count; i += 16) {
+    sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+                           sum0);
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1)) +
+         dotProductScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx512f"))) double
+symmetricDotProductAVX512(const double *coefficients, const double *samples,
+                          int count) {
+  const __m512i reverse = _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  __m512d sum = _mm512_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= count / 2; i += 8) {
+    const __m512d front = _mm512_loadu_pd(samples + i);
+    const __m512d back = _mm512_permutexvar_pd(
+        reverse, _mm512_loadu_pd(samples + count - 8 - i));
+    sum = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients + i),
+                          _mm512_add_pd(front, back), sum);
+  }
+  return _mm512_reduce_add_pd(sum) +
+         symmetricDotProductScalar(coefficients, samples, count, i);
+}
+
+__attribute__((target("avx512f"))) float
+symmetricDotProductAVX512(const float *coefficients, const float *samples,
+                          int count) {
+  const __m512i reverse =
+      _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __m512 sum = _mm512_setzero_ps();
+  int i = 0;
+  for (; i + 16 <= count / 2; i += 16) {
+    const __m512 front = _mm512_loadu_ps(samples + i);
+    const __m512 back = _mm512_permutexvar_ps(
+        reverse, _mm512_loadu_ps(samples + count - 16 - i));
+    sum = _mm512_fmadd_ps(_mm512_loadu_ps(coefficients + i),
+                          _mm512_add_ps(front, back), sum);
+  }
+  return _mm512_reduce_add_ps(sum) +
+         symmetricDotProductScalar(coefficients, samples, count, i);
+}
+
+__attribute__((target("avx512f"))) void
+interleavedDotProductAVX512(const double *coefficients, int count,
+                            const double *frames, int channels,
+                            double *output) {
+  int ch = 0;
+  for (; ch + 8 <= channels; ch += 8) {
+    __m512d sum = _mm512_setzero_pd();
+    for (int k = 0; k < count; k++) {
+      sum = _mm512_fmadd_pd(_mm512_set1_pd(coefficients[k]),
+                            _mm512_loadu_pd(frames + k * channels + ch), sum);
+    }
+    _mm512_storeu_pd(output + ch, sum);
+  }
+  interleavedDotProductScalar(coefficients, count, frames, channels, output,
+                              ch);
+}
+
+__attribute__((target("avx512f"))) void
+interleavedDotProductAVX512(const float *coefficients, int count,
+                            const float *frames, int channels, float *output) {
+  int ch = 0;
+  for (; ch + 16 <= channels; ch += 16) {
+    __m512 sum = _mm512_setzero_ps();
+    for (int k = 0; k < count; k++) {
+      sum = _mm512_fmadd_ps(_mm512_set1_ps(coefficients[k]),
+                            _mm512_loadu_ps(frames + k * channels + ch), sum);
+    }
+    _mm512_storeu_ps(output + ch, sum);
+  }
+  interleavedDotProductScalar(coefficients, count, frames, channels, output,
+                              ch);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // SIMD_X86
+
+#ifdef SIMD_NEON
+
+/*
+ * NEON kernels, 2 doubles or 4 floats per register.
+ * NEON is always available on AArch64.
+ */
+
+double dotProductNEON(const double *a, const double *b, int count) {
+  float64x2_t sum0 = vdupq_n_f64(0);
+  float64x2_t sum1 = vdupq_n_f64(0);
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    sum0 = vfmaq_f64(sum0, vld1q_f64(a + i), vld1q_f64(b + i));
+    sum1 = vfmaq_f64(sum1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+  }
+  for (; i + 2 <= count; i += 2) {
+    sum0 = vfmaq_f64(sum0, vld1q_f64(a + i), vld1q_f64(b + i));
+  }
+  return vaddvq_f64(vaddq_f64(sum0, sum1)) +
+         dotProductScalar(a + i, b + i, count - i);
+}
+
+float dotProductNEON(const float *a, const float *b, int count) {
+  float32x4_t sum0 = vdupq_n_f32(0);
+  float32x4_t sum1 = vdupq_n_f32(0);
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    sum0 = vfmaq_f32(sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+    sum1 = vfmaq_f32(sum1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+  }
+  for (; i + 4 <= count; i += 4) {
+    sum0 = vfmaq_f32(sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+  }
+  return vaddvq_f32(vaddq_f32(sum0, sum1)) +
+         dotProductScalar(a + i, b + i, count - i);
+}
+
+double symmetricDotProductNEON(const double *coefficients,
+                               const double *samples, int count) {
+  float64x2_t sum = vdupq_n_f64(0);
+  int i = 0;
+  for (; i + 2 <= count / 2; i += 2) {
+    const float64x2_t front = vld1q_f64(samples + i);
+    const float64x2_t tail = vld1q_f64(samples + count - 2 - i);
+    // swap lanes to get samples[count-1-i], samples[count-2-i]
+    const float64x2_t back = vextq_f64(tail, tail, 1);
+    sum = vfmaq_f64(sum, vld1q_f64(coefficients + i), vaddq_f64(front, back));
+  }
+  return vaddvq_f64(sum) +
+         symmetricDotProductScalar(coefficients, samples, count, i);
+}
+
+float symmetricDotProductNEON(const float *coefficients, const float *samples,
+                              int count) {
+  float32x4_t sum = vdupq_n_f32(0);
+  int i = 0;
+  for (; i + 4 <= count / 2; i += 4) {
+    const float32x4_t front = vld1q_f32(samples + i);
+    // reverse pairs, then swap halves
+    const float32x4_t tail = vrev64q_f32(vld1q_f32(samples + count - 4 - i));
+    const float32x4_t back = vextq_f32(tail, tail, 2);
+    sum = vfmaq_f32(sum, vld1q_f32(coefficients + i), vaddq_f32(front, back));
+  }
+  return vaddvq_f32(sum) +
+         symmetricDotProductScalar(coefficients, samples, count, i);
+}
+
+void interleavedDotProductNEON(const double *coefficients, int count,
+                               const double *frames, int channels,
+                               double *output) {
+  int ch = 0;
+  for (; ch + 2 <= channels; ch += 2) {
+    float64x2_t sum = vdupq_n_f64(0);
+    for (int k = 0; k < count; k++) {
+      sum = vfmaq_n_f64(sum, vld1q_f64(frames + k * channels + ch),
+                        coefficients[k]);
+    }
+    vst1q_f64(output + ch, sum);
+  }
+  interleavedDotProductScalar(coefficients, count, frames, channels, output,
+                              ch);
+}
+
+void interleavedDotProductNEON(const float *coefficients, int count,
+                               const float *frames, int channels,
+                               float *output) {
+  int ch = 0;
+  for (; ch + 4 <= channels; ch += 4) {
+    float32x4_t sum = vdupq_n_f32(0);
+    for (int k = 0; k < count; k++) {
+      sum = vfmaq_n_f32(sum, vld1q_f32(frames + k * channels + ch),
+                        coefficients[k]);
+    }
+    vst1q_f32(output + ch, sum);
+  }
+  interleavedDotProductScalar(coefficients, count, frames, channels, output,
+                              ch);
+}
+
+#endif // SIMD_NEON
+
+/**
+ * Kernels implemented with a particular instruction set
+ */
+struct Kernels {
+  double (*dotProductDouble)(const double *, const double *, int);
+  float (*dotProductFloat)(const float *, const float *, int);
+  double (*symmetricDotProductDouble)(const double *, const double *, int);
+  float (*symmetricDotProductFloat)(const float *, const float *, int);
+  void (*interleavedDotProductDouble)(const double *, int, const double *, int,
+                                      double *);
+  void (*interleavedDotProductFloat)(const float *, int, const float *, int,
+                                     float *);
+};
+
+const Kernels scalarKernels{
+    dotProductScalar<double>,
+    dotProductScalar<float>,
+    [](const double *c, const double *s, int count) {
+      return symmetricDotProductScalar(c, s, count);
+    },
+    [](const float *c, const float *s, int count) {
+      return symmetricDotProductScalar(c, s, count);
+    },
+    [](const double *c, int count, const double *f, int channels, double *o) {
+      interleavedDotProductScalar(c, count, f, channels, o);
+    },
+    [](const float *c, int count, const float *f, int channels, float *o) {
+      interleavedDotProductScalar(c, count, f, channels, o);
+    }};
+
+#ifdef SIMD_X86
+const Kernels avx2Kernels{dotProductAVX2,          dotProductAVX2,
+                          symmetricDotProductAVX2, symmetricDotProductAVX2,
+                          interleavedDotProductAVX2, interleavedDotProductAVX2};
+
+const Kernels avx512Kernels{
+    dotProductAVX512,          dotProductAVX512,
+    symmetricDotProductAVX512, symmetricDotProductAVX512,
+    interleavedDotProductAVX512, interleavedDotProductAVX512};
+#endif
+
+#ifdef SIMD_NEON
+const Kernels neonKernels{dotProductNEON,          dotProductNEON,
+                          symmetricDotProductNEON, symmetricDotProductNEON,
+                          interleavedDotProductNEON, interleavedDotProductNEON};
+#endif
+
+const Kernels &getKernels(simd::InstructionSet instructionSet) {
+  switch (instructionSet) {
+#ifdef SIMD_X86
+  case simd::InstructionSet::avx2:
+    return avx2Kernels;
+  case simd::InstructionSet::avx512:
+    return avx512Kernels;
+#endif
+#ifdef SIMD_NEON
+  case simd::InstructionSet::neon:
+    return neonKernels;
+#endif
+  default:
+    return scalarKernels;
+  }
+}
+
+/**
+ * Query CPU for the supported vector extensions
+ *
+ * @return supported instruction sets, from the slowest to the fastest one
+ */
+vector<simd::InstructionSet> detectInstructionSets() {
+  vector<simd::InstructionSet> supported{simd::InstructionSet::scalar};
+
+#ifdef SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    supported.push_back(simd::InstructionSet::avx2);
+  }
+  if (__builtin_cpu_supports("avx512f")) {
+    supported.push_back(simd::InstructionSet::avx512);
+  }
+#endif
+#ifdef SIMD_NEON
+  supported.push_back(simd::InstructionSet::neon);
+#endif
+
+  return supported;
+}
+
+const vector<simd::InstructionSet> &supportedInstructionSets() {
+  static const vector<simd::InstructionSet> supported =
+      detectInstructionSets();
+  return supported;
+}
+
+atomic<const Kernels *> &activeKernels() {
+  static atomic<const Kernels *> kernels{
+      &getKernels(supportedInstructionSets().back())};
+  return kernels;
+}
+
+atomic<simd::InstructionSet> &activeInstructionSet() {
+  static atomic<simd::InstructionSet> instructionSet{
+      supportedInstructionSets().back()};
+  return instructionSet;
+}
+
+} // namespace
+
+/**
+ * @return instruction set currently used by the kernels
+ */
+simd::InstructionSet simd::getInstructionSet() {
+  return activeInstructionSet().load();
+}
+
+/**
+ * Force kernels to use the given instruction set.
+ * By default the fastest supported one is used.
+ *
+ * @param instructionSet one of getSupportedInstructionSets()
+ */
+void simd::setInstructionSet(InstructionSet instructionSet) {
+  const auto &supported = supportedInstructionSets();
+  if (find(supported.begin(), supported.end(), instructionSet) ==
+      supported.end()) {
+    throw invalid_argument("setInstructionSet: " + toString(instructionSet) +
+                           " is not supported by this CPU");
+  }
+
+  activeKernels().store(&getKernels(instructionSet));
+  activeInstructionSet().store(instructionSet);
+}
+
+/**
+ * @return instruction sets supported by this CPU, scalar is always supported
+ */
+vector<simd::InstructionSet> simd::getSupportedInstructionSets() {
+  return supportedInstructionSets();
+}
+
+string simd::toString(InstructionSet instructionSet) {
+  switch (instructionSet) {
+  case InstructionSet::avx2:
+    return "AVX2";
+  case InstructionSet::avx512:
+    return "AVX-512";
+  case InstructionSet::neon:
+    return "NEON";
+  default:
+    return "Scalar";
+  }
+}
+
+/**
+ * Sum of element-wise products a[0] * b[0] + ... + a[count-1] * b[count-1]
+ */
+double simd::dotProduct(const double *a, const double *b, int count) {
+  return activeKernels().load()->dotProductDouble(a, b, count);
+}
+
+float simd::dotProduct(const float *a, const float *b, int count) {
+  return activeKernels().load()->dotProductFloat(a, b, count);
+}
+
+/**
+ * Dot product with symmetric coefficients c[k] = c[count-1-k] of linear phase
+ * FIR filters. Samples sharing a coefficient are summed first, so only
+ * (count+1)/2 multiplications are needed.
+ *
+ * @param coefficients count symmetric coefficients, only the first
+ * (count+1)/2 are read
+ * @param samples count samples
+ * @param count number of coefficients
+ */
+double simd::symmetricDotProduct(const double *coefficients,
+                                 const double *samples, int count) {
+  return activeKernels().load()->symmetricDotProductDouble(coefficients,
+                                                           samples, count);
+}
+
+float simd::symmetricDotProduct(const float *coefficients, const float *samples,
+                                int count) {
+  return activeKernels().load()->symmetricDotProductFloat(coefficients,
+                                                          samples, count);
+}
+
+/**
+ * Dot product of the coefficients with each channel of interleaved frames,
+ * all channels are processed at once:
+ * output[ch] = c[0] * frames[ch] + c[1] * frames[channels + ch] + ...
+ *
+ * @param coefficients count coefficients
+ * @param count number of coefficients
+ * @param frames count frames of interleaved channels
+ * @param channels number of channels per frame
+ * @param output buffer for channels results
+ */
+void simd::interleavedDotProduct(const double *coefficients, int count,
+                                 const double *frames, int channels,
+                                 double *output) {
+  activeKernels().load()->interleavedDotProductDouble(coefficients, count,
+                                                      frames, channels, output);
+}
+
+void simd::interleavedDotProduct(const float *coefficients, int count,
+                                 const float *frames, int channels,
+                                 float *output) {
+  activeKernels().load()->interleavedDotProductFloat(coefficients, count,
+                                                     frames, channels, output);
+}
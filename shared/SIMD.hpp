@@ -0,0 +1,35 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <string>
+#include <vector>
+
+namespace simd {
+
+/**
+ * Vector instruction set used by the kernels.
+ * Picked at runtime from the CPU capabilities, scalar code is the fallback.
+ */
+enum class InstructionSet { scalar, avx2, avx512, neon };
+
+InstructionSet getInstructionSet();
+void setInstructionSet(InstructionSet instructionSet);
+std::vector<InstructionSet> getSupportedInstructionSets();
+std::string toString(InstructionSet instructionSet);
+
+double dotProduct(const double *a, const double *b, int count);
+float dotProduct(const float *a, const float *b, int count);
+
+double symmetricDotProduct(const double *coefficients, const double *samples,
+                           int count);
+float symmetricDotProduct(const float *coefficients, const float *samples,
+                          int count);
+
+void interleavedDotProduct(const double *coefficients, int count,
+                           const double *frames, int channels, double *output);
+void interleavedDotProduct(const float *coefficients, int count,
+                           const float *frames, int channels, float *output);
+
+} // namespace simd
+
+#endif // SIMD_H
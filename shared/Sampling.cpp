@@ -47,6 +47,27 @@ std::vector<double> normalize(const std::vector<double> &values) {
   return normalized;
 }
 
+/**
+ * Scale low pass filter coefficients to unity gain at DC
+ *
+ * @param coefficients FIR filter coefficients
+ * @return coefficients summing up to 1
+ */
+std::vector<double> normalizeGain(const std::vector<double> &coefficients) {
+  double sum = 0;
+  for (const double &c : coefficients) {
+    sum += c;
+  }
+
+  std::vector<double> normalized;
+  normalized.reserve(coefficients.size());
+  for (const double &c : coefficients) {
+    normalized.push_back(c / sum);
+  }
+
+  return normalized;
+}
+
 /**
  * Convert given value to dB
  *
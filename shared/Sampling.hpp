@@ -7,6 +7,8 @@ double maxAbsValue(const std::vector<double> &samples);
 
 std::vector<double> normalize(const std::vector<double> &samples);
 
+std::vector<double> normalizeGain(const std::vector<double> &coefficients);
+
 int nyquistFrequency(const int samplingRate);
 
 double toDB(double value);
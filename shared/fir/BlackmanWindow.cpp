@@ -1,9 +1,11 @@
 #include "BlackmanWindow.hpp"
-#include <cmath>
-#include <numbers>
 
 using namespace std;
 
+optional<vector<double>> BlackmanWindow::getCacheKey() const {
+  return vector<double>();
+}
+
 /**
  * Blackman window.
  * Expected attenuation -74dB.
@@ -12,17 +14,9 @@ using namespace std;
  * @return blackman window multipliers
  */
 vector<double> BlackmanWindow::getCoefficients(const int windowSize) const {
-  if (windowSize < 1) {
-    throw invalid_argument("getCoefficients: windowSize must be >= 1");
-  }
-  
-  vector<double> coefficients;
-  coefficients.reserve(windowSize);
+  return getCosineSumCoefficients({0.42, 0.5, 0.08}, windowSize);
+}
 
-  for (int i = 0; i < windowSize; i++) {
-    coefficients.push_back(0.42 - 0.5 * cos((2 * numbers::pi * i) / (windowSize - 1)) +
-                           0.08 * cos((4 * numbers::pi * i) / (windowSize - 1)));
-  }
+double BlackmanWindow::getTransitionWidthFactor() const { return 5.5; }
 
-  return coefficients;
-}
+double BlackmanWindow::getAttenuationDB() const { return 74; }
@@ -2,11 +2,15 @@
 #define BLACKMAN_WINDOW_H
 
 #include "Window.hpp"
+#include <optional>
 #include <vector>
 
 class BlackmanWindow : public Window {
 public:
+  std::optional<std::vector<double>> getCacheKey() const override;
   std::vector<double> getCoefficients(int windowSize) const override;
+  double getTransitionWidthFactor() const override;
+  double getAttenuationDB() const override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "ChebyshevWindow.hpp"
+#include "../FFT.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Dolph-Chebyshev window, all side lobes of the window spectrum are at the
+ * same level.
+ *
+ * @param attenuationDB side lobes level below the main lobe (dB)
+ */
+ChebyshevWindow::ChebyshevWindow(double attenuationDB)
+    : attenuationDB{attenuationDB} {
+  if (attenuationDB <= 0) {
+    throw invalid_argument("ChebyshevWindow: attenuationDB must be > 0");
+  }
+}
+
+optional<vector<double>> ChebyshevWindow::getCacheKey() const {
+  return vector<double>{attenuationDB};
+}
+
+/**
+ * Window spectrum is a Chebyshev polynomial T[N-1](x0 * cos(pi * k / N))
+ * sampled at N frequencies, window is it's inverse DFT normalized to 1 at
+ * the center.
+ *
+ * @param windowSize
+ * @return chebyshev window multipliers
+ */
+vector<double> ChebyshevWindow::getCoefficients(int windowSize) const {
+  if (windowSize < 1) {
+    throw invalid_argument("getCoefficients: windowSize must be >= 1");
+  }
+  if (windowSize == 1) {
+    return {1};
+  }
+
+  const int order = windowSize - 1;
+  const double x0 = cosh(acosh(pow(10, attenuationDB / 20)) / order);
+
+  vector<complex<double>> spectrum;
+  spectrum.reserve(windowSize);
+  for (int k = 0; k < windowSize; k++) {
+    const double x = x0 * cos(numbers::pi * k / windowSize);
+    double value;
+    if (x > 1) {
+      value = cosh(order * acosh(x));
+    } else if (x < -1) {
+      value = (windowSize % 2 == 1 ? 1 : -1) * cosh(order * acosh(-x));
+    } else {
+      value = cos(order * acos(x));
+    }
+    // even sized windows are centered between samples
+    spectrum.push_back(windowSize % 2 == 1
+                           ? complex<double>(value)
+                           : value * polar(1.0, numbers::pi * k / windowSize));
+  }
+
+  const auto timeDomain = fft::direct(spectrum);
+
+  // time domain is centered at 0, rotate it to the middle of the window
+  const int half = windowSize / 2;
+  vector<double> coefficients;
+  coefficients.reserve(windowSize);
+  if (windowSize % 2 == 1) {
+    for (int i = half; i > 0; i--) {
+      coefficients.push_back(timeDomain[i].real());
+    }
+    for (int i = 0; i <= half; i++) {
+      coefficients.push_back(timeDomain[i].real());
+    }
+  } else {
+    for (int i = half; i > 0; i--) {
+      coefficients.push_back(timeDomain[i].real());
+    }
+    for (int i = 1; i <= half; i++) {
+      coefficients.push_back(timeDomain[i].real());
+    }
+  }
+
+  const double maxValue =
+      *max_element(coefficients.begin(), coefficients.end());
+  for (auto &coefficient : coefficients) {
+    coefficient /= maxValue;
+  }
+
+  return coefficients;
+}
+
+/**
+ * Side lobes don't decay, so the filter transition band is about 15% wider
+ * than Kaiser's for the same attenuation (fitted for 30..90 dB)
+ */
+double ChebyshevWindow::getTransitionWidthFactor() const {
+  return (max(attenuationDB, 21.0) - 5.5) / 12.9;
+}
+
+double ChebyshevWindow::getAttenuationDB() const { return attenuationDB; }
@@ -0,0 +1,21 @@
+#ifndef CHEBYSHEV_WINDOW_H
+#define CHEBYSHEV_WINDOW_H
+
+#include "Window.hpp"
+#include <optional>
+#include <vector>
+
+class ChebyshevWindow : public Window {
+public:
+  explicit ChebyshevWindow(double attenuationDB);
+
+  std::optional<std::vector<double>> getCacheKey() const override;
+  std::vector<double> getCoefficients(int windowSize) const override;
+  double getTransitionWidthFactor() const override;
+  double getAttenuationDB() const override;
+
+private:
+  const double attenuationDB;
+};
+
+#endif
@@ -0,0 +1,178 @@
+#include "DecimationPlan.hpp"
+#include "FIRFilter.hpp"
+#include "KaiserWindow.hpp"
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Stages decimating by the given factors in order.
+ *
+ * Every stage keeps the pass band [0, passBandFrequency] and attenuates
+ * everything that would alias into the final band: stop band of a stage
+ * starts at its output rate minus half the final output rate, so only the
+ * last stage needs a narrow transition band.
+ *
+ * @param factors decimation factor of every stage
+ * @param passBandFrequency pass band edge of the whole cascade
+ * @param attenuationDB stop band attenuation of every stage (dB)
+ */
+DecimationPlan::DecimationPlan(int inputSamplingRate,
+                               const vector<int> &factors,
+                               int passBandFrequency, double attenuationDB)
+    : inputSamplingRate{inputSamplingRate},
+      passBandFrequency{passBandFrequency}, attenuationDB{attenuationDB} {
+  if (inputSamplingRate < 1) {
+    throw invalid_argument("DecimationPlan: inputSamplingRate must be >= 1");
+  }
+  if (factors.empty()) {
+    throw invalid_argument("DecimationPlan: factors must not be empty");
+  }
+  if (passBandFrequency < 1) {
+    throw invalid_argument("DecimationPlan: passBandFrequency must be >= 1");
+  }
+
+  const int factor =
+      accumulate(factors.begin(), factors.end(), 1, multiplies<int>());
+  for (int stageFactor : factors) {
+    if (stageFactor < 1) {
+      throw invalid_argument("DecimationPlan: factors must be >= 1");
+    }
+  }
+  if (factor < 1 || inputSamplingRate % factor != 0) {
+    throw invalid_argument(
+        "DecimationPlan: inputSamplingRate must be divisible by the factors");
+  }
+  outputSamplingRate = inputSamplingRate / factor;
+
+  const KaiserWindow window(attenuationDB);
+
+  int samplingRate = inputSamplingRate;
+  for (int stageFactor : factors) {
+    const int stageOutputSamplingRate = samplingRate / stageFactor;
+    // outputSamplingRate / 2 for the last stage,
+    // rounded towards the pass band for odd rates
+    const int stopBandEdge =
+        stageOutputSamplingRate - (outputSamplingRate + 1) / 2;
+    const int transitionLength = (stopBandEdge - passBandFrequency) / 2;
+    if (transitionLength < 1) {
+      throw invalid_argument("DecimationPlan: passBandFrequency must be less "
+                             "than outputSamplingRate / 2");
+    }
+
+    DecimationStage stage;
+    stage.factor = stageFactor;
+    stage.inputSamplingRate = samplingRate;
+    stage.transitionLength = transitionLength;
+    stage.cutoffFrequency = stopBandEdge - transitionLength;
+    stage.coefficientsCount = FIRFilter::getOptimalCoefficientsCount(
+        samplingRate, window, transitionLength);
+    // one dot product per output sample
+    stage.macsPerSecond =
+        static_cast<double>(stage.coefficientsCount) * stageOutputSamplingRate;
+    stage.latency = (stage.coefficientsCount - 1) / (2.0 * samplingRate);
+    stages.push_back(stage);
+
+    samplingRate = stageOutputSamplingRate;
+  }
+}
+
+int DecimationPlan::getInputSamplingRate() const { return inputSamplingRate; }
+
+int DecimationPlan::getOutputSamplingRate() const {
+  return outputSamplingRate;
+}
+
+int DecimationPlan::getFactor() const {
+  return inputSamplingRate / outputSamplingRate;
+}
+
+int DecimationPlan::getPassBandFrequency() const { return passBandFrequency; }
+
+double DecimationPlan::getAttenuationDB() const { return attenuationDB; }
+
+const vector<DecimationStage> &DecimationPlan::getStages() const {
+  return stages;
+}
+
+/**
+ * @return multiply-accumulates per second of all stages
+ */
+double DecimationPlan::getMACsPerSecond() const {
+  double macsPerSecond = 0;
+  for (const auto &stage : stages) {
+    macsPerSecond += stage.macsPerSecond;
+  }
+  return macsPerSecond;
+}
+
+/**
+ * @return group delay of the cascade (seconds)
+ */
+double DecimationPlan::getLatency() const {
+  double latency = 0;
+  for (const auto &stage : stages) {
+    latency += stage.latency;
+  }
+  return latency;
+}
+
+/**
+ * Find the cheapest cascade by searching all ordered factorizations of
+ * inputSamplingRate / outputSamplingRate into up to maxStagesCount factors.
+ * Cost is the total MAC/s with Kaiser window filter lengths, lower latency
+ * wins between equally expensive plans.
+ *
+ * @param passBandFrequency pass band edge, less than outputSamplingRate / 2
+ * @param attenuationDB stop band attenuation (dB)
+ * @param maxStagesCount max number of stages
+ */
+DecimationPlan DecimationPlan::createOptimal(int inputSamplingRate,
+                                             int outputSamplingRate,
+                                             int passBandFrequency,
+                                             double attenuationDB,
+                                             int maxStagesCount) {
+  if (outputSamplingRate < 1 || inputSamplingRate < outputSamplingRate ||
+      inputSamplingRate % outputSamplingRate != 0) {
+    throw invalid_argument("createOptimal: inputSamplingRate must be a "
+                           "multiple of outputSamplingRate");
+  }
+  if (maxStagesCount < 1) {
+    throw invalid_argument("createOptimal: maxStagesCount must be >= 1");
+  }
+
+  const int factor = inputSamplingRate / outputSamplingRate;
+  optional<DecimationPlan> best;
+  vector<int> factors;
+
+  function<void(int)> search = [&](int remainingFactor) {
+    // the last stage takes the rest
+    factors.push_back(remainingFactor);
+    DecimationPlan plan(inputSamplingRate, factors, passBandFrequency,
+                        attenuationDB);
+    if (!best || plan.getMACsPerSecond() < best->getMACsPerSecond() ||
+        (plan.getMACsPerSecond() == best->getMACsPerSecond() &&
+         plan.getLatency() < best->getLatency())) {
+      best = plan;
+    }
+    factors.pop_back();
+
+    if (static_cast<int>(factors.size()) + 1 == maxStagesCount) {
+      return;
+    }
+    for (int stageFactor = 2; stageFactor < remainingFactor; stageFactor++) {
+      if (remainingFactor % stageFactor == 0) {
+        factors.push_back(stageFactor);
+        search(remainingFactor / stageFactor);
+        factors.pop_back();
+      }
+    }
+  };
+  search(factor);
+
+  return *best;
+}
@@ -0,0 +1,56 @@
+#ifndef DECIMATION_PLAN_H
+#define DECIMATION_PLAN_H
+
+#include <vector>
+
+/**
+ * Single stage of a multistage decimator
+ */
+struct DecimationStage {
+  int factor;
+  int inputSamplingRate;
+  int cutoffFrequency;
+  // distance from cutoff to stop band (Hz)
+  int transitionLength;
+  int coefficientsCount;
+  // multiply-accumulates per second
+  double macsPerSecond;
+  // group delay (seconds)
+  double latency;
+};
+
+/**
+ * Cascade of low pass filters and downsamplers by integer factors,
+ * see MultistageDecimator to process samples with it.
+ * Filters are designed with a Kaiser window for the given attenuation.
+ */
+class DecimationPlan {
+public:
+  static constexpr int defaultMaxStagesCount = 4;
+
+  DecimationPlan(int inputSamplingRate, const std::vector<int> &factors,
+                 int passBandFrequency, double attenuationDB);
+
+  int getInputSamplingRate() const;
+  int getOutputSamplingRate() const;
+  int getFactor() const;
+  int getPassBandFrequency() const;
+  double getAttenuationDB() const;
+  const std::vector<DecimationStage> &getStages() const;
+  double getMACsPerSecond() const;
+  double getLatency() const;
+
+  static DecimationPlan
+  createOptimal(int inputSamplingRate, int outputSamplingRate,
+                int passBandFrequency, double attenuationDB,
+                int maxStagesCount = defaultMaxStagesCount);
+
+private:
+  int inputSamplingRate;
+  int outputSamplingRate;
+  int passBandFrequency;
+  double attenuationDB;
+  std::vector<DecimationStage> stages;
+};
+
+#endif
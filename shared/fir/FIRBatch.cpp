@@ -0,0 +1,228 @@
+#include "FIRBatch.hpp"
+#include "FIRFilter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+int FIRBatchResult::size() const {
+  return max(0, static_cast<int>(coefficientsOffsets.size()) - 1);
+}
+
+span<const double> FIRBatchResult::getCoefficients(int design) const {
+  return span<const double>(coefficients)
+      .subspan(coefficientsOffsets[design], coefficientsOffsets[design + 1] -
+                                                coefficientsOffsets[design]);
+}
+
+span<const double> FIRBatchResult::getMagnitudesDB(int design) const {
+  return span<const double>(magnitudesDB)
+      .subspan(design * responseSize, responseSize);
+}
+
+span<const double> FIRBatchResult::getPhaseShifts(int design) const {
+  return span<const double>(phaseShifts)
+      .subspan(design * responseSize, responseSize);
+}
+
+/**
+ * @param threadsCount number of threads designing filters, including the one
+ * calling design(), 0 to use all hardware threads
+ */
+FIRBatchDesigner::FIRBatchDesigner(int threadsCount) {
+  if (threadsCount < 0) {
+    throw invalid_argument("FIRBatchDesigner: threadsCount must be >= 0");
+  }
+  if (threadsCount == 0) {
+    threadsCount = max(1u, thread::hardware_concurrency());
+  }
+
+  // calling thread is one of the workers
+  threads.reserve(threadsCount - 1);
+  for (int t = 0; t < threadsCount - 1; t++) {
+    threads.emplace_back(&FIRBatchDesigner::work, this, t);
+  }
+}
+
+FIRBatchDesigner::~FIRBatchDesigner() {
+  {
+    lock_guard<mutex> lock(jobMutex);
+    stopping = true;
+  }
+  jobStarted.notify_all();
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+/**
+ * @return number of threads designing filters, including the calling one
+ */
+int FIRBatchDesigner::getThreadsCount() const { return threads.size() + 1; }
+
+/**
+ * Pool thread loop: wait for a batch, take part in it, report completion
+ */
+void FIRBatchDesigner::work(int threadIndex) {
+  uint64_t doneJobNumber = 0;
+  while (true) {
+    function<void(int)> currentJob;
+    {
+      unique_lock<mutex> lock(jobMutex);
+      jobStarted.wait(lock,
+                      [&] { return stopping || jobNumber != doneJobNumber; });
+      if (stopping) {
+        return;
+      }
+      doneJobNumber = jobNumber;
+      currentJob = job;
+    }
+
+    currentJob(threadIndex);
+
+    {
+      lock_guard<mutex> lock(jobMutex);
+      busyThreadsCount--;
+    }
+    jobFinished.notify_all();
+  }
+}
+
+/**
+ * Design many FIR filters in parallel, e.g. to sweep cutoff frequency,
+ * filter size and window when looking for the best design.
+ *
+ * Designs are picked by the pool threads one by one from a shared counter,
+ * so that threads stay busy even if filter sizes differ a lot. Each thread
+ * reuses its own FFT plans and buffers (see FFT.cpp) across batches, results
+ * are written to preallocated slices of the flat result arrays without
+ * locking.
+ *
+ * If any design is invalid, remaining designs are skipped and the first
+ * exception is rethrown.
+ *
+ * @param designs filter parameters for every design
+ * @param grid frequencies to calculate each design's response at
+ * @param threadsCount number of threads to use, at most getThreadsCount(),
+ * 0 to use all of them
+ * @return coefficients and responses of all designs in the input order
+ */
+FIRBatchResult
+FIRBatchDesigner::design(const vector<FIRDesignParameters> &designs,
+                         const FrequencyGrid &grid, int threadsCount) {
+  if (threadsCount < 0) {
+    throw invalid_argument("designFIRBatch: threadsCount must be >= 0");
+  }
+
+  FIRBatchResult result;
+  result.coefficientsOffsets.reserve(designs.size() + 1);
+  result.coefficientsOffsets.push_back(0);
+  for (const auto &design : designs) {
+    if (design.window == nullptr) {
+      throw invalid_argument("designFIRBatch: window must be set");
+    }
+    if (design.coefficientsCount < 1) {
+      throw invalid_argument(
+          "designFIRBatch: coefficientsCount must be >= 1");
+    }
+    result.coefficientsOffsets.push_back(result.coefficientsOffsets.back() +
+                                         design.coefficientsCount);
+  }
+
+  const int designsCount = designs.size();
+  result.responseSize = grid.size();
+  result.coefficients.resize(result.coefficientsOffsets.back());
+  result.magnitudesDB.resize(designsCount * result.responseSize);
+  result.phaseShifts.resize(designsCount * result.responseSize);
+
+  if (threadsCount == 0 || threadsCount > getThreadsCount()) {
+    threadsCount = getThreadsCount();
+  }
+  threadsCount = min(threadsCount, designsCount);
+
+  atomic<int> nextDesign{0};
+  atomic<bool> failed{false};
+  exception_ptr firstError;
+  mutex errorMutex;
+
+  auto worker = [&]() {
+    while (!failed) {
+      const int i = nextDesign++;
+      if (i >= designsCount) {
+        return;
+      }
+
+      try {
+        const auto &design = designs[i];
+        const FIRFilter filter(design.passType, design.cutoffFrequency,
+                               design.coefficientsCount, *design.window,
+                               design.samplingRate);
+
+        const auto coefficients = filter.getFilterCoefficients();
+        copy(coefficients.begin(), coefficients.end(),
+             result.coefficients.begin() + result.coefficientsOffsets[i]);
+
+        const auto response = filter.calculateFrequencyResponse(grid);
+        const auto magnitudesDB = response.getMagnitudesDB();
+        const auto phaseShifts = response.getPhaseShifts();
+        copy(magnitudesDB.begin(), magnitudesDB.end(),
+             result.magnitudesDB.begin() + i * result.responseSize);
+        copy(phaseShifts.begin(), phaseShifts.end(),
+             result.phaseShifts.begin() + i * result.responseSize);
+      } catch (...) {
+        lock_guard<mutex> lock(errorMutex);
+        if (!firstError) {
+          firstError = current_exception();
+        }
+        failed = true;
+      }
+    }
+  };
+
+  lock_guard<mutex> designLock(designMutex);
+  if (threadsCount > 1) {
+    {
+      lock_guard<mutex> lock(jobMutex);
+      // calling thread takes one of the threadsCount places
+      job = [&, threadsCount](int threadIndex) {
+        if (threadIndex < threadsCount - 1) {
+          worker();
+        }
+      };
+      jobNumber++;
+      busyThreadsCount = threads.size();
+    }
+    jobStarted.notify_all();
+  }
+
+  worker();
+
+  if (threadsCount > 1) {
+    unique_lock<mutex> lock(jobMutex);
+    jobFinished.wait(lock, [&] { return busyThreadsCount == 0; });
+    job = nullptr;
+  }
+
+  if (firstError) {
+    rethrow_exception(firstError);
+  }
+
+  return result;
+}
+
+/**
+ * Design a batch of FIR filters on a pool shared by all callers,
+ * see FIRBatchDesigner::design
+ *
+ * @param threadsCount number of worker threads, 0 to use all hardware threads
+ */
+FIRBatchResult designFIRBatch(const vector<FIRDesignParameters> &designs,
+                              const FrequencyGrid &grid, int threadsCount) {
+  static FIRBatchDesigner designer;
+  return designer.design(designs, grid, threadsCount);
+}
@@ -0,0 +1,84 @@
+#ifndef FIR_BATCH_H
+#define FIR_BATCH_H
+
+#include "../FilterPass.hpp"
+#include "../FrequencyGrid.hpp"
+#include "Window.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * Parameters of a single FIR filter design, see FIRFilter constructor.
+ * Window must outlive the batch computation.
+ */
+struct FIRDesignParameters {
+  FilterPass passType;
+  int cutoffFrequency;
+  int coefficientsCount;
+  const Window *window;
+  int samplingRate;
+};
+
+/**
+ * Coefficients and responses of a batch of FIR filter designs stored in flat
+ * arrays. Coefficients of design i are
+ * coefficients[coefficientsOffsets[i] .. coefficientsOffsets[i+1]),
+ * its response values are [i * responseSize .. (i+1) * responseSize).
+ */
+struct FIRBatchResult {
+  std::vector<int> coefficientsOffsets;
+  std::vector<double> coefficients;
+  int responseSize = 0;
+  std::vector<double> magnitudesDB;
+  std::vector<double> phaseShifts;
+
+  int size() const;
+  std::span<const double> getCoefficients(int design) const;
+  std::span<const double> getMagnitudesDB(int design) const;
+  std::span<const double> getPhaseShifts(int design) const;
+};
+
+/**
+ * Persistent pool of worker threads designing FIR filter batches.
+ * Threads live as long as the designer, so that their FFT buffers and
+ * ideal impulse responses cached per thread are reused by later batches.
+ * Batches submitted from several threads run one after another.
+ */
+class FIRBatchDesigner {
+public:
+  explicit FIRBatchDesigner(int threadsCount = 0);
+  ~FIRBatchDesigner();
+
+  FIRBatchDesigner(const FIRBatchDesigner &) = delete;
+  FIRBatchDesigner &operator=(const FIRBatchDesigner &) = delete;
+
+  int getThreadsCount() const;
+  FIRBatchResult design(const std::vector<FIRDesignParameters> &designs,
+                        const FrequencyGrid &grid, int threadsCount = 0);
+
+private:
+  std::vector<std::thread> threads;
+  // batch being designed, called by every pool thread with its index
+  std::function<void(int)> job;
+  std::uint64_t jobNumber = 0;
+  int busyThreadsCount = 0;
+  bool stopping = false;
+  std::mutex jobMutex;
+  std::condition_variable jobStarted;
+  std::condition_variable jobFinished;
+  // one batch at a time
+  std::mutex designMutex;
+
+  void work(int threadIndex);
+};
+
+FIRBatchResult designFIRBatch(const std::vector<FIRDesignParameters> &designs,
+                              const FrequencyGrid &grid,
+                              int threadsCount = 0);
+
+#endif
@@ -1,8 +1,10 @@
 #include "FIRFilter.hpp"
-#include "../FFT.hpp"
+#include "../LRUCache.hpp"
 #include "../Sampling.hpp"
+#include "FIRResponse.hpp"
 #include "Welle.hpp"
 #include <cmath>
+#include <functional>
 #include <numbers>
 
 using namespace std;
@@ -25,7 +27,10 @@ FIRFilter::FIRFilter(FilterPass passType, int cutoffFrequency,
     throw invalid_argument("FIRFilter: cutoffFrequency must be < "
                            "samplingRate/2 (Nyquist frequency");
   }
-  filterCoefficients = calculateFilterCoefficients(coefficientsCount);
+  filterCoefficients = calculateFilterCoefficients(
+      passType, cutoffFrequency, coefficientsCount, window, samplingRate);
+  // responses on any grid are relative to the same peak
+  peakMagnitude = firPeakMagnitude(filterCoefficients);
 }
 
 int FIRFilter::getCutoffFrequency() const { return cutoffFrequency; }
@@ -78,36 +83,139 @@ vector<double> FIRFilter::generateIdealFrequencyResponse() const {
  * @param coefficientsCount target number of coefficients
  * @return normalized [-1, 1] filter coefficients with applied window
  */
-vector<double>
-FIRFilter::calculateFilterCoefficients(int coefficientsCount) const {
+vector<double> FIRFilter::calculateFilterCoefficients(FilterPass passType,
+                                                      int cutoffFrequency,
+                                                      int coefficientsCount,
+                                                      const Window &window,
+                                                      int samplingRate) {
   if (coefficientsCount < 1) {
     throw invalid_argument(
         "calculateFilterCoefficients: coefficientsCount must be >= 1");
   }
 
-  auto idealFrequencyResponse = generateIdealFrequencyResponse();
-  vector<complex<double>> filterTimeDomain =
-      fft::inverse(fft::toComplexVector(idealFrequencyResponse));
+  // Using low-pass symmetric response to model all type of filters,
+  // see generateIdealFrequencyResponse()
+  const int modellingLowPassCutoffFrequency =
+      passType == FilterPass::lowPass
+          ? cutoffFrequency
+          : nyquistFrequency(samplingRate) - cutoffFrequency;
 
-  vector<double> coefficients;
-  coefficients.reserve(coefficientsCount);
+  auto coefficients = calculateIdealImpulseResponse(
+      modellingLowPassCutoffFrequency, samplingRate, coefficientsCount);
+
+  shiftFilterCoefficients(passType, samplingRate, coefficients);
+  window.applyInPlace(coefficients);
+  return normalize(coefficients);
+}
+
+namespace {
+
+struct IdealImpulseResponseKey {
+  double cutoffFrequency;
+  int samplingRate;
+
+  bool operator==(const IdealImpulseResponseKey &other) const = default;
+};
+
+struct IdealImpulseResponseKeyHash {
+  size_t operator()(const IdealImpulseResponseKey &key) const {
+    return hash<double>{}(key.cutoffFrequency) * 31 +
+           hash<int>{}(key.samplingRate);
+  }
+};
+
+// half of the ideal impulse response h[0..n] per (cutoff, samplingRate),
+// grown on demand, so that designs differing in size only reuse it
+constexpr int idealImpulseResponsesCacheMaxEntries = 16;
+constexpr size_t idealImpulseResponsesCacheMaxBytes = 16 * 1024 * 1024;
+
+thread_local LRUCache<IdealImpulseResponseKey, vector<double>,
+                      IdealImpulseResponseKeyHash>
+    idealImpulseResponsesCache{idealImpulseResponsesCacheMaxEntries,
+                               idealImpulseResponsesCacheMaxBytes};
+
+/**
+ * Periodic sinc h[n] = sin(pi * W * n / F) / sin(pi * n / F)
+ */
+double periodicSinc(double passBandWidth, int n, int samplingRate) {
+  if (n % samplingRate == 0) {
+    // sin(W*x)/sin(x) -> W*cos(W*k*pi)/cos(k*pi) when x -> k*pi
+    const int k = n / samplingRate;
+    return passBandWidth * cos(numbers::pi * passBandWidth * k) /
+           cos(numbers::pi * k);
+  }
+  return sin(numbers::pi * passBandWidth * n / samplingRate) /
+         sin(numbers::pi * n / samplingRate);
+}
+
+} // namespace
+
+/**
+ * Ideal low pass filter impulse response, i.e. an inverse DFT of the ideal
+ * frequency response with 1 gain for [0..C) and ((F-C)..F) frequencies,
+ * 0 for the rest.
+ *
+ * Such response has 2C-1 pass band bins centered around 0 Hz, so it's inverse
+ * DFT (not normalized) is a periodic sinc (Dirichlet kernel):
+ * h[n] = sin(pi * (2C-1) * n / F) / sin(pi * n / F), h[0] = 2C-1
+ *
+ * Evaluating the formula directly takes O(coefficientsCount) instead of
+ * inverse FFT over samplingRate points. Formula is also valid for fractional
+ * cutoff frequencies.
+ *
+ * Impulse response is symmetrical around n = 0.
+ * For even number of coefficient Ne=coefficientsCount/2,
+ * concat [Ne .. 0) and [0 .. Ne)
+ * For odd number of coefficient No=Ne-1
+ * concat [No .. 0) and [0 .. No]
+ *
+ * Calculated h[0..n] values are cached per thread, so that the response
+ * of a different size with the same cutoff and sampling rate is a copy.
+ *
+ * @param cutoffFrequency low pass cutoff frequency C (Hz)
+ * @param samplingRate sampling rate F (Hz)
+ * @param coefficientsCount target number of coefficients
+ * @return ideal impulse response centered at coefficientsCount/2
+ */
+vector<double> FIRFilter::calculateIdealImpulseResponse(double cutoffFrequency,
+                                                        int samplingRate,
+                                                        int coefficientsCount) {
+  if (coefficientsCount < 1) {
+    throw invalid_argument(
+        "calculateIdealImpulseResponse: coefficientsCount must be >= 1");
+  }
+  if (samplingRate < 1) {
+    throw invalid_argument(
+        "calculateIdealImpulseResponse: samplingRate must be >= 1");
+  }
 
-  // Frequency response is symmetrical starting from samplingRate / 2.
-  //
-  // For even number of coefficient Ne=coefficientsCount/2,
-  // concat [Ne .. 0) and [0 .. Ne)
-  // For odd number of coefficient No=Ne-1
-  // concat [No .. 0) and [0 .. No]
-  const bool isEvenCount = coefficientsCount % 2 == 0;
+  const double passBandWidth = 2 * cutoffFrequency - 1;
+  const int center = coefficientsCount / 2;
+  // h[0..center] covers both halves
+  const int halfSize = center + 1;
 
-  for (int i = coefficientsCount / 2; i > 0; i--) {
-    coefficients.push_back(filterTimeDomain[i].real());
+  const IdealImpulseResponseKey key{cutoffFrequency, samplingRate};
+  const vector<double> *half = idealImpulseResponsesCache.get(key);
+  if (!half || static_cast<int>(half->size()) < halfSize) {
+    vector<double> grown = half ? *half : vector<double>();
+    grown.reserve(halfSize);
+    for (int n = grown.size(); n < halfSize; n++) {
+      grown.push_back(periodicSinc(passBandWidth, n, samplingRate));
+    }
+    const size_t bytes = grown.size() * sizeof(double);
+    idealImpulseResponsesCache.put(key, std::move(grown), bytes);
+    half = idealImpulseResponsesCache.get(key);
   }
-  for (int i = 0; i <= coefficientsCount / 2 - (isEvenCount ? 1 : 0); i++) {
-    coefficients.push_back(filterTimeDomain[i].real());
+
+  vector<double> coefficients;
+  coefficients.reserve(coefficientsCount);
+  for (int i = 0; i < coefficientsCount; i++) {
+    const int n = abs(center - i);
+    coefficients.push_back(half ? (*half)[n]
+                                : periodicSinc(passBandWidth, n, samplingRate));
   }
 
-  return normalize(window.apply(shiftFilterCoefficients(coefficients)));
+  return coefficients;
 }
 
 /**
@@ -125,25 +233,20 @@ FIRFilter::calculateFilterCoefficients(int coefficientsCount) const {
  * This is achieved by multiplying each filter coefficient by sine wave sampled
  * at f/2 frequency.
  *
- * @return low-pass filter coefficients with applied shift to model high or band
- * pass filters
+ * @param coefficients low-pass filter coefficients to shift in place to model
+ * high or band pass filters
  */
-vector<double> FIRFilter::shiftFilterCoefficients(
-    const vector<double> &unshiftedCoefficients) const {
-
-  vector<double> shiftedCoefficients(unshiftedCoefficients);
-
+void FIRFilter::shiftFilterCoefficients(FilterPass passType, int samplingRate,
+                                        vector<double> &coefficients) {
   if (passType == FilterPass::highPass) {
     auto sine = welle::SineWave<int>(samplingRate);
     // shift to Pi/2 to sample only high and low sine values
     auto period = sine.generatePeriod(samplingRate / 2, 2, numbers::pi / 2);
 
-    for (unsigned int i = 0; i < shiftedCoefficients.size(); i++) {
-      shiftedCoefficients[i] *= period[i % period.size()];
+    for (unsigned int i = 0; i < coefficients.size(); i++) {
+      coefficients[i] *= period[i % period.size()];
     }
   }
-
-  return shiftedCoefficients;
 }
 
 /**
@@ -155,33 +258,30 @@ vector<FilterResponse> FIRFilter::calculateResponse() const {
   const int fromFrequency = 1;
   const int toFrequency = nyquistFrequency(samplingRate);
 
-  vector<double> paddedCoefficients(filterCoefficients);
-  for (int i = filterCoefficients.size(); i < samplingRate; i++) {
-    paddedCoefficients.push_back(0);
-  }
-
-  auto fftResult = fft::direct(fft::toComplexVector(paddedCoefficients));
-  vector<double> magnitudes;
-  vector<double> phaseShifts;
-  magnitudes.reserve(toFrequency);
-  phaseShifts.reserve(toFrequency);
-
-  for (int i = fromFrequency - 1; i < toFrequency; i++) {
-    magnitudes.push_back(abs(fftResult[i]));
-    phaseShifts.push_back(arg(fftResult[i]));
-  }
-  magnitudes = normalize(magnitudes);
-  for (double &value : magnitudes) {
-    value = toDB(abs(value));
-  }
+  return calculateResponse(FrequencyGrid::linear(
+      fromFrequency - 1, toFrequency - 1, toFrequency - fromFrequency + 1));
+}
 
-  vector<FilterResponse> response;
-  response.reserve(magnitudes.size());
-  for (unsigned int i = 0; i < magnitudes.size(); i++) {
-      response.push_back(FilterResponse(magnitudes[i], phaseShifts[i]));
-  }
+/**
+ * Calculate FIR filter frequency response at the given frequencies
+ *
+ * @param grid frequencies to evaluate
+ * @return magnitudes (dB) [-Inf, 0] and phase shifts for each grid frequency
+ */
+vector<FilterResponse>
+FIRFilter::calculateResponse(const FrequencyGrid &grid) const {
+  return calculateFrequencyResponse(grid).toFilterResponses();
+}
 
-  return response;
+/**
+ * Calculate FIR filter frequency response at the given frequencies
+ *
+ * @param grid frequencies to evaluate
+ * @return grid frequencies with magnitudes (dB) [-Inf, 0] and phase shifts
+ */
+FrequencyResponse<>
+FIRFilter::calculateFrequencyResponse(const FrequencyGrid &grid) const {
+  return firResponse(filterCoefficients, samplingRate, grid, peakMagnitude);
 }
 
 /**
@@ -212,3 +312,252 @@ int FIRFilter::getOptimalCoefficientsCount(int samplingRate,
   // return odd number of coefficients to have a linear phase characteristics
   return count % 2 == 0 ? count + 1 : count;
 }
+
+/**
+ * Get optimal coefficients count for the given window, stop band attenuation
+ * is the one of the window.
+ * Transition length is counted from the cutoff frequency to the stop band,
+ * so the whole transition band is twice as wide.
+ *
+ * @param window window to design the filter with
+ * @param transitionLength distance from cutoff to stop band (Hz)
+ * @return odd number of coefficients
+ */
+int FIRFilter::getOptimalCoefficientsCount(int samplingRate,
+                                           const Window &window,
+                                           int transitionLength) {
+  if (transitionLength < 1) {
+    throw invalid_argument(
+        "getOptimalCoefficientsCount: transitionLength must be >= 1");
+  }
+  int count = ceil(window.getTransitionWidthFactor() * samplingRate /
+                   (2 * transitionLength)) +
+              1;
+  // return odd number of coefficients to have a linear phase characteristics
+  return count % 2 == 0 ? count + 1 : count;
+}
+
+/**
+ * Get transition length of a filter designed with the given window
+ *
+ * @param window window to design the filter with
+ * @param coefficientsCount number of filter coefficients
+ * @return distance from cutoff to stop band (Hz)
+ */
+int FIRFilter::getTransitionLength(int samplingRate, const Window &window,
+                                   int coefficientsCount) {
+  if (coefficientsCount < 2) {
+    throw invalid_argument(
+        "getTransitionLength: coefficientsCount must be >= 2");
+  }
+  return ceil(window.getTransitionWidthFactor() * samplingRate /
+              (2 * (coefficientsCount - 1)));
+}
+
+/**
+ * Design low pass filter for decimation or interpolation by factor.
+ * Stop band starts at the Nyquist frequency of the lower rate, so nothing
+ * above the window attenuation is aliased (decimation) or imaged
+ * (interpolation) into the pass band.
+ *
+ * @param factor decimation or interpolation factor
+ * @param samplingRate higher sampling rate, input rate of a decimator or
+ * output rate of an interpolator
+ * @param window window to design the filter with, must outlive the filter
+ * @param transitionLength distance from cutoff to stop band (Hz)
+ * @return low pass filter at samplingRate
+ */
+FIRFilter FIRFilter::createAntiAliasingFilter(int factor, int samplingRate,
+                                              const Window &window,
+                                              int transitionLength) {
+  if (factor < 1) {
+    throw invalid_argument("createAntiAliasingFilter: factor must be >= 1");
+  }
+  const int cutoffFrequency =
+      samplingRate / (2 * factor) - transitionLength;
+  if (cutoffFrequency < 1) {
+    throw invalid_argument("createAntiAliasingFilter: transitionLength must "
+                           "be less than samplingRate / (2 * factor)");
+  }
+
+  return FIRFilter(
+      FilterPass::lowPass, cutoffFrequency,
+      getOptimalCoefficientsCount(samplingRate, window, transitionLength),
+      window, samplingRate);
+}
+
+namespace {
+
+// DFT points per filter coefficient when measuring a response,
+// enough to catch the side lobe peaks within a fraction of dB
+constexpr int measurementOversampling = 8;
+// measured search gives up at this multiple of the window estimate
+constexpr int maxCoefficientsCountFactor = 4;
+
+/**
+ * Magnitudes (dB) of the filter at DFT bins in [0, samplingRate/2],
+ * evaluated with a single FFT. The bins are dense enough to hold the peak,
+ * so they're relative to it without measuring it separately.
+ */
+FrequencyResponse<> measureResponse(const vector<double> &coefficients,
+                                    int samplingRate) {
+  const int coefficientsCount = coefficients.size();
+  int dftSize = 1024;
+  while (dftSize < measurementOversampling * coefficientsCount) {
+    dftSize *= 2;
+  }
+  return firResponse(coefficients, samplingRate,
+                     FrequencyGrid::linear(0, samplingRate / 2.0,
+                                           dftSize / 2 + 1),
+                     0);
+}
+
+/**
+ * Measured attenuation: the lowest pass band magnitude over the highest
+ * stop band one, bands are transitionLength away from the cutoff frequency
+ */
+double responseAttenuationDB(const FrequencyResponse<> &response,
+                             FilterPass passType, int cutoffFrequency,
+                             int transitionLength) {
+  double minPassBandDB = INFINITY;
+  double maxStopBandDB = -INFINITY;
+  for (int i = 0; i < response.size(); i++) {
+    const double frequency = response.getFrequencies()[i];
+    const double magnitudeDB = response.getMagnitudesDB()[i];
+    const bool lowPass = passType == FilterPass::lowPass;
+    if (lowPass ? frequency <= cutoffFrequency - transitionLength
+                : frequency >= cutoffFrequency + transitionLength) {
+      minPassBandDB = min(minPassBandDB, magnitudeDB);
+    }
+    if (lowPass ? frequency >= cutoffFrequency + transitionLength
+                : frequency <= cutoffFrequency - transitionLength) {
+      maxStopBandDB = max(maxStopBandDB, magnitudeDB);
+    }
+  }
+  return minPassBandDB - maxStopBandDB;
+}
+
+void checkTransitionBand(int cutoffFrequency, int transitionLength,
+                         int samplingRate) {
+  if (transitionLength < 1 || cutoffFrequency - transitionLength < 0 ||
+      cutoffFrequency + transitionLength > nyquistFrequency(samplingRate)) {
+    throw invalid_argument("transition band must be within "
+                           "[0, samplingRate/2]");
+  }
+}
+
+} // namespace
+
+/**
+ * Attenuation measured on the filter response
+ *
+ * @param transitionLength distance from cutoff to pass and stop bands (Hz)
+ * @return lowest pass band magnitude over the highest stop band magnitude
+ * (dB)
+ */
+double FIRFilter::measureAttenuationDB(int transitionLength) const {
+  checkTransitionBand(cutoffFrequency, transitionLength, samplingRate);
+  return responseAttenuationDB(
+      measureResponse(filterCoefficients, samplingRate), passType,
+      cutoffFrequency, transitionLength);
+}
+
+/**
+ * Find the smallest odd number of coefficients, which filter response
+ * reaches the attenuation within the transition band.
+ *
+ * Unlike the estimates, accounts for the actual window and cutoff frequency.
+ * Starts from the window estimate, then binary searches the measured designs.
+ *
+ * @param transitionLength distance from cutoff to pass and stop bands (Hz)
+ * @param attenuationDB target attenuation (dB)
+ * @param window window to design the filter with
+ * @param isCancelled checked before every design, stops the search early
+ * returning the current upper bound, which may not reach the attenuation yet
+ * @return odd number of coefficients
+ * @throw invalid_argument if the window doesn't reach the attenuation
+ */
+int FIRFilter::findOptimalCoefficientsCount(
+    FilterPass passType, int cutoffFrequency, int transitionLength,
+    double attenuationDB, const Window &window, int samplingRate,
+    const function<bool()> &isCancelled) {
+  checkTransitionBand(cutoffFrequency, transitionLength, samplingRate);
+
+  // only coefficients are designed, filters' own peak isn't needed
+  auto reached = [&](int coefficientsCount) {
+    const auto coefficients =
+        calculateFilterCoefficients(passType, cutoffFrequency,
+                                    coefficientsCount, window, samplingRate);
+    return responseAttenuationDB(measureResponse(coefficients, samplingRate),
+                                 passType, cutoffFrequency,
+                                 transitionLength) >= attenuationDB;
+  };
+
+  auto cancelled = [&] { return isCancelled && isCancelled(); };
+
+  const int estimate =
+      getOptimalCoefficientsCount(samplingRate, window, transitionLength);
+  // odd counts, low doesn't reach the attenuation, high does
+  int low = 1;
+  int high = estimate;
+  while (!cancelled() && !reached(high)) {
+    low = high;
+    high = 2 * high + 1;
+    if (high > maxCoefficientsCountFactor * estimate) {
+      throw invalid_argument(
+          "findOptimalCoefficientsCount: window doesn't reach attenuationDB");
+    }
+  }
+  while (high - low > 2 && !cancelled()) {
+    const int middle = low + (high - low) / 4 * 2;
+    if (reached(middle)) {
+      high = middle;
+    } else {
+      low = middle;
+    }
+  }
+  return high;
+}
+
+/**
+ * Find the shortest transition length, at which the measured filter
+ * response reaches the attenuation.
+ * Designs the filter once, measured attenuation grows with the transition.
+ *
+ * @param attenuationDB target attenuation (dB)
+ * @param window window to design the filter with
+ * @return distance from cutoff to pass and stop bands (Hz)
+ * @throw invalid_argument if the attenuation isn't reached within
+ * [0, samplingRate/2]
+ */
+int FIRFilter::findTransitionLength(FilterPass passType, int cutoffFrequency,
+                                    int coefficientsCount,
+                                    double attenuationDB, const Window &window,
+                                    int samplingRate) {
+  const FIRFilter filter(passType, cutoffFrequency, coefficientsCount, window,
+                         samplingRate);
+  const auto response =
+      measureResponse(filter.getFilterCoefficients(), samplingRate);
+  auto reached = [&](int transitionLength) {
+    return responseAttenuationDB(response, passType, cutoffFrequency,
+                                 transitionLength) >= attenuationDB;
+  };
+
+  // widest transition band keeping both bands within [0, samplingRate/2]
+  int low = 0;
+  int high = min(cutoffFrequency,
+                 nyquistFrequency(samplingRate) - cutoffFrequency);
+  if (high < 1 || !reached(high)) {
+    throw invalid_argument(
+        "findTransitionLength: filter doesn't reach attenuationDB");
+  }
+  while (high - low > 1) {
+    const int middle = low + (high - low) / 2;
+    if (reached(middle)) {
+      high = middle;
+    } else {
+      low = middle;
+    }
+  }
+  return high;
+}
@@ -4,6 +4,7 @@
 #include "../Filter.hpp"
 #include "../FilterPass.hpp"
 #include "Window.hpp"
+#include <functional>
 #include <vector>
 
 class FIRFilter : public Filter {
@@ -17,13 +18,35 @@ public:
 
   std::vector<double> getFilterCoefficients() const override;
   std::vector<FilterResponse> calculateResponse() const override;
+  std::vector<FilterResponse>
+  calculateResponse(const FrequencyGrid &grid) const override;
+  FrequencyResponse<>
+  calculateFrequencyResponse(const FrequencyGrid &grid) const override;
 
   std::vector<double> generateIdealFrequencyResponse() const;
+  double measureAttenuationDB(int transitionLength) const;
 
+  static std::vector<double>
+  calculateIdealImpulseResponse(double cutoffFrequency, int samplingRate,
+                                int coefficientsCount);
   static int getOptimalCoefficientsCount(int samplingRate, double attenuationDB,
                                          int transitionLength);
   static int getTransitionLength(int samplingRate, double attenuationDB,
                                  int coefficientsCount);
+  static int getOptimalCoefficientsCount(int samplingRate, const Window &window,
+                                         int transitionLength);
+  static int getTransitionLength(int samplingRate, const Window &window,
+                                 int coefficientsCount);
+  static int findOptimalCoefficientsCount(
+      FilterPass passType, int cutoffFrequency, int transitionLength,
+      double attenuationDB, const Window &window, int samplingRate,
+      const std::function<bool()> &isCancelled = nullptr);
+  static int findTransitionLength(FilterPass passType, int cutoffFrequency,
+                                  int coefficientsCount, double attenuationDB,
+                                  const Window &window, int samplingRate);
+  static FIRFilter createAntiAliasingFilter(int factor, int samplingRate,
+                                            const Window &window,
+                                            int transitionLength);
 
 private:
   const FilterPass passType;
@@ -31,10 +54,14 @@ private:
   const Window &window;
   const int samplingRate;
   std::vector<double> filterCoefficients;
+  double peakMagnitude;
 
-  std::vector<double> shiftFilterCoefficients(
-      const std::vector<double> &unshiftedCoefficients) const;
-  std::vector<double> calculateFilterCoefficients(int coefficientsCount) const;
+  static void shiftFilterCoefficients(FilterPass passType, int samplingRate,
+                                      std::vector<double> &coefficients);
+  static std::vector<double>
+  calculateFilterCoefficients(FilterPass passType, int cutoffFrequency,
+                              int coefficientsCount, const Window &window,
+                              int samplingRate);
 };
 
 #endif
@@ -0,0 +1,212 @@
+#include "FIRProcessor.hpp"
+#include "../FFT.hpp"
+#include "../SIMD.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Streaming FIR filter convolution.
+ *
+ * Short filters are applied directly in time domain.
+ * Long filters are split into partitions of partitionSize coefficients, each
+ * partition is convolved in frequency domain using overlap-save method with
+ * 2*partitionSize FFTs. Partitioned convolution adds partitionSize samples
+ * of latency.
+ *
+ * All buffers are allocated in the constructor, processing doesn't allocate.
+ *
+ * @param coefficients FIR filter coefficients, see
+ * FIRFilter::getFilterCoefficients()
+ * @param partitionSize number of coefficients per partition (long filters
+ * only)
+ */
+FIRProcessor::FIRProcessor(const vector<double> &coefficients,
+                           int partitionSize)
+    : coefficients{coefficients} {
+  if (coefficients.empty()) {
+    throw invalid_argument("FIRProcessor: coefficients must not be empty");
+  }
+  if (partitionSize < 1) {
+    throw invalid_argument("FIRProcessor: partitionSize must be >= 1");
+  }
+
+  const int coefficientsCount = coefficients.size();
+  if (coefficientsCount <= maxDirectFormCoefficients) {
+    delayLine.resize(2 * coefficientsCount, 0);
+    symmetric = isSymmetric(coefficients);
+    return;
+  }
+
+  this->partitionSize = partitionSize;
+  partitionsCount = (coefficientsCount + partitionSize - 1) / partitionSize;
+
+  const int fftSize = 2 * partitionSize;
+  const int spectrumSize = fft::halfSpectrumSize(fftSize);
+
+  partitionSpectra.resize(partitionsCount * spectrumSize);
+  inputSpectra.resize(partitionsCount * spectrumSize, 0);
+  inputBlock.resize(fftSize, 0);
+  outputBlock.resize(fftSize, 0);
+  accumulator.resize(spectrumSize, 0);
+  pendingOutput.resize(partitionSize, 0);
+
+  // zero padded partitions spectra,
+  // inverse FFT normalization is applied here once
+  vector<double> partition(fftSize);
+  for (int p = 0; p < partitionsCount; p++) {
+    fill(partition.begin(), partition.end(), 0);
+    for (int i = 0; i < partitionSize; i++) {
+      const int index = p * partitionSize + i;
+      if (index < coefficientsCount) {
+        partition[i] = coefficients[index] / fftSize;
+      }
+    }
+    fft::directReal(partition.data(), &partitionSpectra[p * spectrumSize],
+                    fftSize);
+  }
+}
+
+/**
+ * @return true if c[k] == c[count-1-k] for all k
+ */
+bool FIRProcessor::isSymmetric(const vector<double> &coefficients) {
+  const int count = coefficients.size();
+  double maxCoefficient = 0;
+  for (double c : coefficients) {
+    maxCoefficient = max(maxCoefficient, abs(c));
+  }
+
+  const double tolerance = 1e-12 * maxCoefficient;
+  for (int i = 0; i < count / 2; i++) {
+    if (abs(coefficients[i] - coefficients[count - 1 - i]) > tolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @return true if filter is convolved in frequency domain
+ */
+bool FIRProcessor::isPartitioned() const { return partitionsCount > 0; }
+
+/**
+ * @return number of samples output is delayed by in addition to the filter's
+ * own group delay
+ */
+int FIRProcessor::getLatency() const { return partitionSize; }
+
+/**
+ * Clear filter state as if no samples were processed before
+ */
+void FIRProcessor::reset() {
+  fill(delayLine.begin(), delayLine.end(), 0);
+  delayLinePosition = 0;
+
+  fill(inputSpectra.begin(), inputSpectra.end(), 0);
+  fill(inputBlock.begin(), inputBlock.end(), 0);
+  fill(pendingOutput.begin(), pendingOutput.end(), 0);
+  inputSpectraPosition = 0;
+  blockPosition = 0;
+}
+
+/**
+ * Filter next block of samples
+ *
+ * @param input count input samples
+ * @param output buffer for count filtered samples, may be the same as input
+ * @param count number of samples
+ */
+void FIRProcessor::process(const double *input, double *output, int count) {
+  if (!isPartitioned()) {
+    for (int i = 0; i < count; i++) {
+      output[i] = processDirectForm(input[i]);
+    }
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    const double sample = input[i];
+    output[i] = pendingOutput[blockPosition];
+    inputBlock[partitionSize + blockPosition] = sample;
+
+    if (++blockPosition == partitionSize) {
+      processPartition();
+      blockPosition = 0;
+    }
+  }
+}
+
+/**
+ * Filter next block of samples
+ *
+ * @param input input samples
+ * @return filtered samples
+ */
+vector<double> FIRProcessor::process(const vector<double> &input) {
+  vector<double> output(input.size());
+  process(input.data(), output.data(), input.size());
+
+  return output;
+}
+
+/**
+ * Vout[n] = c[0] * Vin[n] + c[1] * Vin[n-1] + ... + c[k] * Vin[n-k]
+ */
+double FIRProcessor::processDirectForm(double sample) {
+  const int coefficientsCount = coefficients.size();
+
+  delayLinePosition =
+      delayLinePosition == 0 ? coefficientsCount - 1 : delayLinePosition - 1;
+  delayLine[delayLinePosition] = sample;
+  delayLine[delayLinePosition + coefficientsCount] = sample;
+
+  // delayLine[delayLinePosition + k] is Vin[n-k]
+  const double *history = &delayLine[delayLinePosition];
+  if (symmetric) {
+    return simd::symmetricDotProduct(coefficients.data(), history,
+                                     coefficientsCount);
+  }
+  return simd::dotProduct(coefficients.data(), history, coefficientsCount);
+}
+
+/**
+ * Convolve last 2*partitionSize input samples with every partition.
+ *
+ * Input spectra of the previous blocks are kept in a frequency-domain
+ * delay line, so each new block needs one direct and one inverse FFT.
+ */
+void FIRProcessor::processPartition() {
+  const int fftSize = 2 * partitionSize;
+  const int spectrumSize = fft::halfSpectrumSize(fftSize);
+
+  fft::directReal(inputBlock.data(),
+                  &inputSpectra[inputSpectraPosition * spectrumSize], fftSize);
+
+  fill(accumulator.begin(), accumulator.end(), 0);
+  for (int p = 0; p < partitionsCount; p++) {
+    // p-th partition is applied to the input block delayed by p blocks
+    const int block =
+        (inputSpectraPosition - p + partitionsCount) % partitionsCount;
+    const complex<double> *x = &inputSpectra[block * spectrumSize];
+    const complex<double> *h = &partitionSpectra[p * spectrumSize];
+    for (int i = 0; i < spectrumSize; i++) {
+      accumulator[i] += x[i] * h[i];
+    }
+  }
+
+  fft::inverseReal(accumulator.data(), outputBlock.data(), fftSize);
+
+  // the first half is circular convolution garbage
+  copy(outputBlock.begin() + partitionSize, outputBlock.end(),
+       pendingOutput.begin());
+
+  // current block becomes the overlapping half of the next one
+  copy(inputBlock.begin() + partitionSize, inputBlock.end(),
+       inputBlock.begin());
+
+  inputSpectraPosition = (inputSpectraPosition + 1) % partitionsCount;
+}
@@ -0,0 +1,56 @@
+#ifndef FIR_PROCESSOR_H
+#define FIR_PROCESSOR_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * Streaming FIR filter convolution.
+ * Keeps delay line between process() calls, so that a continuous stream
+ * can be filtered in arbitrary sized blocks.
+ */
+class FIRProcessor {
+public:
+  // longer filters are convolved in frequency domain
+  static constexpr int maxDirectFormCoefficients = 128;
+  static constexpr int defaultPartitionSize = 256;
+
+  explicit FIRProcessor(const std::vector<double> &coefficients,
+                        int partitionSize = defaultPartitionSize);
+
+  void process(const double *input, double *output, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset();
+
+  bool isPartitioned() const;
+  int getLatency() const;
+
+  static bool isSymmetric(const std::vector<double> &coefficients);
+
+private:
+  const std::vector<double> coefficients;
+  // linear phase filters need half the multiplications
+  bool symmetric = false;
+
+  // direct form state, input samples are stored twice
+  // so that the last coefficientsCount samples are always contiguous
+  std::vector<double> delayLine;
+  int delayLinePosition = 0;
+
+  // uniformly partitioned overlap-save state
+  int partitionSize = 0;
+  int partitionsCount = 0;
+  std::vector<std::complex<double>> partitionSpectra;
+  std::vector<std::complex<double>> inputSpectra;
+  int inputSpectraPosition = 0;
+  std::vector<double> inputBlock;
+  std::vector<double> outputBlock;
+  std::vector<std::complex<double>> accumulator;
+  std::vector<double> pendingOutput;
+  int blockPosition = 0;
+
+  double processDirectForm(double sample);
+  void processPartition();
+};
+
+#endif
@@ -0,0 +1,206 @@
+#include "FIRResponse.hpp"
+#include "../FFT.hpp"
+#include "../Sampling.hpp"
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+namespace {
+
+// approximate floating point operations per Goertzel step and per FFT
+// butterfly, used to pick the cheaper evaluation method
+constexpr double goertzelCostPerTap = 3;
+constexpr double fftCostPerPoint = 2.5;
+// grids with finer steps than samplingRate / maxDFTSize are never FFT bins,
+// such a transform wouldn't fit in memory anyway
+constexpr double maxDFTSize = 1 << 26;
+
+// DFT points per coefficient when looking for the response peak
+constexpr int peakOversampling = 8;
+
+/**
+ * Evaluate DTFT of the coefficients at a single frequency using
+ * Goertzel algorithm: one real multiplication per coefficient
+ *
+ * @param coefficients FIR filter coefficients h[n]
+ * @param omega normalized angular frequency (radians per sample)
+ * @return H(e^jw) = sum(h[n] * e^(-jwn))
+ */
+complex<double> goertzel(const vector<double> &coefficients, double omega) {
+  const double cosine = 2 * cos(omega);
+  double s1 = 0;
+  double s2 = 0;
+  for (const double &c : coefficients) {
+    const double s0 = c + cosine * s1 - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+
+  // y = s[N-1] - e^(-jw) * s[N-2] equals sum(h[n] * e^(jw(N-1-n)))
+  const complex<double> y = s1 - polar(1.0, -omega) * s2;
+  return y * polar(1.0, -omega * (coefficients.size() - 1.0));
+}
+
+/**
+ * Check if grid frequencies are exactly the bins of some DFT:
+ * f[i] = (offset + i) * samplingRate / dftSize
+ *
+ * @return DFT size or 0 if grid doesn't match DFT bins
+ */
+int matchingDFTSize(int samplingRate, const FrequencyGrid &grid,
+                    int &offset) {
+  if (!grid.isUniform()) {
+    return 0;
+  }
+
+  const double tolerance = 1e-9;
+  const double dftSize = samplingRate / grid.getStep();
+  const double firstBin = grid.getFrequencies()[0] / grid.getStep();
+  if (!(dftSize <= maxDFTSize) || !(abs(firstBin) <= maxDFTSize)) {
+    return 0;
+  }
+  if (abs(dftSize - round(dftSize)) > tolerance ||
+      abs(firstBin - round(firstBin)) > tolerance || round(dftSize) < 1) {
+    return 0;
+  }
+
+  offset = round(firstBin);
+  return round(dftSize);
+}
+
+/**
+ * Evaluate DTFT at DFT bins with a single real FFT.
+ * Coefficients are folded (time-aliased) if there're more of them
+ * than DFT points, which keeps bin values exact.
+ */
+vector<complex<double>> fftTransferFunction(const vector<double> &coefficients,
+                                            int dftSize, int offset,
+                                            int pointsCount) {
+  vector<double> folded(dftSize, 0);
+  for (unsigned int i = 0; i < coefficients.size(); i++) {
+    folded[i % dftSize] += coefficients[i];
+  }
+
+  auto halfSpectrum = fft::directReal(folded);
+
+  vector<complex<double>> result;
+  result.reserve(pointsCount);
+  for (int i = 0; i < pointsCount; i++) {
+    const int bin = ((offset + i) % dftSize + dftSize) % dftSize;
+    // spectrum of a real signal is Hermitian
+    result.push_back(bin < static_cast<int>(halfSpectrum.size())
+                         ? halfSpectrum[bin]
+                         : conj(halfSpectrum[dftSize - bin]));
+  }
+
+  return result;
+}
+
+} // namespace
+
+/**
+ * Evaluate FIR filter transfer function H(e^jw) at the given frequencies.
+ *
+ * Either evaluates each frequency directly with Goertzel algorithm
+ * in O(coefficients * points), or, if grid frequencies are DFT bins,
+ * runs a single FFT in O(N log N), whichever is cheaper.
+ *
+ * @param coefficients FIR filter coefficients
+ * @param samplingRate sampling rate (Hz)
+ * @param grid frequencies to evaluate
+ * @return complex transfer function values for each grid frequency
+ */
+vector<complex<double>> firTransferFunction(const vector<double> &coefficients,
+                                            int samplingRate,
+                                            const FrequencyGrid &grid) {
+  if (samplingRate < 1) {
+    throw invalid_argument("firTransferFunction: samplingRate must be >= 1");
+  }
+
+  int offset = 0;
+  const int dftSize = matchingDFTSize(samplingRate, grid, offset);
+  if (dftSize > 0) {
+    const double directCost =
+        goertzelCostPerTap * coefficients.size() * grid.size();
+    const double fftCost =
+        fftCostPerPoint * dftSize * log2(dftSize + 1) + coefficients.size();
+    if (fftCost < directCost) {
+      return fftTransferFunction(coefficients, dftSize, offset, grid.size());
+    }
+  }
+
+  vector<complex<double>> result;
+  result.reserve(grid.size());
+  for (const double &frequency : grid.getFrequencies()) {
+    result.push_back(
+        goertzel(coefficients, 2 * numbers::pi * frequency / samplingRate));
+  }
+
+  return result;
+}
+
+/**
+ * Peak magnitude of the transfer function over [0, samplingRate/2],
+ * sampled on a dense zero padded DFT, independent of any requested grid.
+ * Filters calculate it once, so that responses on any grid are relative
+ * to the same level.
+ *
+ * @param coefficients FIR filter coefficients
+ * @return max |H(e^jw)|, 0 if there're no coefficients
+ */
+double firPeakMagnitude(const vector<double> &coefficients) {
+  if (coefficients.empty()) {
+    return 0;
+  }
+  int dftSize = 1024;
+  while (dftSize < peakOversampling * static_cast<int>(coefficients.size())) {
+    dftSize *= 2;
+  }
+  vector<double> padded(dftSize, 0);
+  copy(coefficients.begin(), coefficients.end(), padded.begin());
+
+  double peak = 0;
+  for (const complex<double> &value : fft::directReal(padded)) {
+    peak = max(peak, abs(value));
+  }
+  return peak;
+}
+
+/**
+ * Calculate FIR filter frequency response at the given frequencies
+ *
+ * @param coefficients FIR filter coefficients
+ * @param samplingRate sampling rate (Hz)
+ * @param grid frequencies to evaluate
+ * @param peakMagnitude filter peak magnitude, see firPeakMagnitude
+ * @return magnitudes (dB) [-Inf, 0] relative to the peak magnitude of the
+ * filter, so that any grid gives the same levels, and phase shifts for each
+ * grid frequency
+ */
+FrequencyResponse<> firResponse(const vector<double> &coefficients,
+                                int samplingRate, const FrequencyGrid &grid,
+                                double peakMagnitude) {
+  auto transferFunction = firTransferFunction(coefficients, samplingRate, grid);
+
+  double peak = peakMagnitude;
+  vector<double> magnitudes;
+  magnitudes.reserve(transferFunction.size());
+  for (const complex<double> &value : transferFunction) {
+    magnitudes.push_back(abs(value));
+    // the dense DFT may miss the top of the peak by a tiny bit
+    peak = max(peak, magnitudes.back());
+  }
+
+  vector<double> magnitudesDB;
+  vector<double> phaseShifts;
+  magnitudesDB.reserve(magnitudes.size());
+  phaseShifts.reserve(magnitudes.size());
+  for (unsigned int i = 0; i < magnitudes.size(); i++) {
+    magnitudesDB.push_back(peak > 0 ? toDB(magnitudes[i] / peak) : -INFINITY);
+    phaseShifts.push_back(arg(transferFunction[i]));
+  }
+
+  return FrequencyResponse<>(grid.getFrequencies(), std::move(magnitudesDB),
+                             std::move(phaseShifts));
+}
@@ -0,0 +1,19 @@
+#ifndef FIR_RESPONSE_H
+#define FIR_RESPONSE_H
+
+#include "../FrequencyResponse.hpp"
+#include "../FrequencyGrid.hpp"
+#include <complex>
+#include <vector>
+
+std::vector<std::complex<double>>
+firTransferFunction(const std::vector<double> &coefficients, int samplingRate,
+                    const FrequencyGrid &grid);
+
+double firPeakMagnitude(const std::vector<double> &coefficients);
+
+FrequencyResponse<> firResponse(const std::vector<double> &coefficients,
+                                int samplingRate, const FrequencyGrid &grid,
+                                double peakMagnitude);
+
+#endif
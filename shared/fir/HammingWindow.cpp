@@ -0,0 +1,22 @@
+#include "HammingWindow.hpp"
+
+using namespace std;
+
+optional<vector<double>> HammingWindow::getCacheKey() const {
+  return vector<double>();
+}
+
+/**
+ * Hamming window.
+ * Expected attenuation -53dB.
+ *
+ * @param windowSize
+ * @return hamming window multipliers
+ */
+vector<double> HammingWindow::getCoefficients(int windowSize) const {
+  return getCosineSumCoefficients({0.54, 0.46}, windowSize);
+}
+
+double HammingWindow::getTransitionWidthFactor() const { return 3.3; }
+
+double HammingWindow::getAttenuationDB() const { return 53; }
@@ -0,0 +1,16 @@
+#ifndef HAMMING_WINDOW_H
+#define HAMMING_WINDOW_H
+
+#include "Window.hpp"
+#include <optional>
+#include <vector>
+
+class HammingWindow : public Window {
+public:
+  std::optional<std::vector<double>> getCacheKey() const override;
+  std::vector<double> getCoefficients(int windowSize) const override;
+  double getTransitionWidthFactor() const override;
+  double getAttenuationDB() const override;
+};
+
+#endif
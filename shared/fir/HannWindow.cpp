@@ -0,0 +1,22 @@
+#include "HannWindow.hpp"
+
+using namespace std;
+
+optional<vector<double>> HannWindow::getCacheKey() const {
+  return vector<double>();
+}
+
+/**
+ * Hann window.
+ * Expected attenuation -44dB.
+ *
+ * @param windowSize
+ * @return hann window multipliers
+ */
+vector<double> HannWindow::getCoefficients(int windowSize) const {
+  return getCosineSumCoefficients({0.5, 0.5}, windowSize);
+}
+
+double HannWindow::getTransitionWidthFactor() const { return 4.0; }
+
+double HannWindow::getAttenuationDB() const { return 44; }
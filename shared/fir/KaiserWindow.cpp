@@ -0,0 +1,97 @@
+#include "KaiserWindow.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+/**
+ * Zeroth order modified Bessel function of the first kind
+ */
+double besselI0(double x) {
+  double sum = 1;
+  double term = 1;
+  const double quarterSquare = x * x / 4;
+  for (int k = 1; term > sum * 1e-17; k++) {
+    term *= quarterSquare / (k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+} // namespace
+
+/**
+ * Kaiser window with the shape parameter chosen to reach the given stop band
+ * attenuation with the narrowest transition band.
+ *
+ * @param attenuationDB target stop band attenuation (dB)
+ */
+KaiserWindow::KaiserWindow(double attenuationDB)
+    : attenuationDB{attenuationDB}, beta{getBeta(attenuationDB)} {
+  if (attenuationDB <= 0) {
+    throw invalid_argument("KaiserWindow: attenuationDB must be > 0");
+  }
+}
+
+/**
+ * Shape parameter for the given attenuation, Kaiser's empirical formula
+ *
+ * @param attenuationDB target stop band attenuation (dB)
+ * @return beta
+ */
+double KaiserWindow::getBeta(double attenuationDB) {
+  if (attenuationDB > 50) {
+    return 0.1102 * (attenuationDB - 8.7);
+  }
+  if (attenuationDB >= 21) {
+    return 0.5842 * pow(attenuationDB - 21, 0.4) +
+           0.07886 * (attenuationDB - 21);
+  }
+  return 0;
+}
+
+double KaiserWindow::getBeta() const { return beta; }
+
+optional<vector<double>> KaiserWindow::getCacheKey() const {
+  return vector<double>{beta};
+}
+
+/**
+ * Kaiser window.
+ * W[n] = I0(beta * sqrt(1 - (2n/(N-1) - 1)^2)) / I0(beta)
+ *
+ * @param windowSize
+ * @return kaiser window multipliers
+ */
+vector<double> KaiserWindow::getCoefficients(int windowSize) const {
+  if (windowSize < 1) {
+    throw invalid_argument("getCoefficients: windowSize must be >= 1");
+  }
+  if (windowSize == 1) {
+    return {1};
+  }
+
+  vector<double> coefficients;
+  coefficients.reserve(windowSize);
+
+  const double denominator = besselI0(beta);
+  for (int i = 0; i < windowSize; i++) {
+    const double x = 2.0 * i / (windowSize - 1) - 1;
+    coefficients.push_back(besselI0(beta * sqrt(max(0.0, 1 - x * x))) /
+                           denominator);
+  }
+
+  return coefficients;
+}
+
+/**
+ * Kaiser's estimate N - 1 = (A - 7.95) / (14.36 * transitionWidth / F)
+ */
+double KaiserWindow::getTransitionWidthFactor() const {
+  return (max(attenuationDB, 21.0) - 7.95) / 14.36;
+}
+
+double KaiserWindow::getAttenuationDB() const { return attenuationDB; }
@@ -0,0 +1,25 @@
+#ifndef KAISER_WINDOW_H
+#define KAISER_WINDOW_H
+
+#include "Window.hpp"
+#include <optional>
+#include <vector>
+
+class KaiserWindow : public Window {
+public:
+  explicit KaiserWindow(double attenuationDB);
+
+  std::optional<std::vector<double>> getCacheKey() const override;
+  std::vector<double> getCoefficients(int windowSize) const override;
+  double getTransitionWidthFactor() const override;
+  double getAttenuationDB() const override;
+
+  double getBeta() const;
+  static double getBeta(double attenuationDB);
+
+private:
+  const double attenuationDB;
+  const double beta;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "MultichannelFIRProcessor.hpp"
+#include "../SIMD.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+// frames per chunk when channels are filtered one by one
+constexpr int channelChunkSize = 256;
+
+} // namespace
+
+/**
+ * Streaming FIR filter for many channels.
+ *
+ * Short filters are applied in time domain to blocks of channelBlockSize
+ * channels. Each block keeps an interleaved delay line, so that all channels
+ * of a block are multiplied by the same coefficient at once and coefficients
+ * are read once per frame. Long filters use FIRProcessor per channel.
+ *
+ * @param coefficients FIR filter coefficients
+ * @param channels number of channels
+ */
+MultichannelFIRProcessor::MultichannelFIRProcessor(
+    const vector<double> &coefficients, int channels)
+    : coefficients{coefficients}, channels{channels} {
+  if (coefficients.empty()) {
+    throw invalid_argument(
+        "MultichannelFIRProcessor: coefficients must not be empty");
+  }
+  if (channels < 1) {
+    throw invalid_argument("MultichannelFIRProcessor: channels must be >= 1");
+  }
+
+  const int coefficientsCount = coefficients.size();
+  if (coefficientsCount > FIRProcessor::maxDirectFormCoefficients) {
+    channelProcessors.reserve(channels);
+    for (int ch = 0; ch < channels; ch++) {
+      channelProcessors.emplace_back(coefficients);
+    }
+    channelInput.resize(channelChunkSize);
+    channelOutput.resize(channelChunkSize);
+    return;
+  }
+
+  for (int first = 0; first < channels; first += channelBlockSize) {
+    const int count = min(channelBlockSize, channels - first);
+    channelBlocks.push_back(
+        {first, count, vector<double>(2 * coefficientsCount * count, 0)});
+  }
+  blockOutput.resize(channelBlockSize);
+}
+
+/**
+ * @param filter FIR filter to take coefficients from
+ * @param channels number of channels
+ */
+MultichannelFIRProcessor::MultichannelFIRProcessor(const FIRFilter &filter,
+                                                   int channels)
+    : MultichannelFIRProcessor(filter.getFilterCoefficients(), channels) {}
+
+int MultichannelFIRProcessor::getChannelsCount() const { return channels; }
+
+/**
+ * @return true if filter is convolved in frequency domain
+ */
+bool MultichannelFIRProcessor::isPartitioned() const {
+  return !channelProcessors.empty();
+}
+
+/**
+ * @return number of samples output is delayed by in addition to the filter's
+ * own group delay
+ */
+int MultichannelFIRProcessor::getLatency() const {
+  return isPartitioned() ? channelProcessors[0].getLatency() : 0;
+}
+
+/**
+ * Clear state of all channels as if no samples were processed before
+ */
+void MultichannelFIRProcessor::reset() {
+  for (auto &block : channelBlocks) {
+    fill(block.delayLine.begin(), block.delayLine.end(), 0);
+    block.delayLinePosition = 0;
+  }
+  for (auto &processor : channelProcessors) {
+    processor.reset();
+  }
+}
+
+/**
+ * Filter next frames of all channels
+ *
+ * @param input frames * channels samples in the given layout
+ * @param output buffer for frames * channels filtered samples in the same
+ * layout, may be the same as input
+ * @param frames number of samples per channel
+ * @param layout planar or interleaved channels
+ */
+void MultichannelFIRProcessor::process(const double *input, double *output,
+                                       int frames, ChannelLayout layout) {
+  if (isPartitioned()) {
+    processPartitioned(input, output, frames, layout);
+    return;
+  }
+
+  // all frames of one block are processed before moving to the next one,
+  // so that its delay line stays in cache
+  for (auto &block : channelBlocks) {
+    processBlock(block, input, output, frames, layout);
+  }
+}
+
+/**
+ * Filter next samples of all channels
+ *
+ * @param input samples per channel, all channels of the same size
+ * @return filtered samples per channel
+ */
+vector<vector<double>> MultichannelFIRProcessor::process(
+    const vector<vector<double>> &input) {
+  if (static_cast<int>(input.size()) != channels) {
+    throw invalid_argument("MultichannelFIRProcessor: expecting " +
+                           to_string(channels) + " channels");
+  }
+
+  const int frames = input[0].size();
+  vector<double> planar;
+  planar.reserve(frames * channels);
+  for (const auto &samples : input) {
+    if (static_cast<int>(samples.size()) != frames) {
+      throw invalid_argument(
+          "MultichannelFIRProcessor: channels must be of the same size");
+    }
+    planar.insert(planar.end(), samples.begin(), samples.end());
+  }
+
+  process(planar.data(), planar.data(), frames, ChannelLayout::planar);
+
+  vector<vector<double>> output;
+  for (int ch = 0; ch < channels; ch++) {
+    output.emplace_back(planar.begin() + ch * frames,
+                        planar.begin() + (ch + 1) * frames);
+  }
+  return output;
+}
+
+/**
+ * Vout[n][ch] = c[0] * Vin[n][ch] + c[1] * Vin[n-1][ch] + ... for every channel
+ * of the block
+ */
+void MultichannelFIRProcessor::processBlock(ChannelBlock &block,
+                                            const double *input,
+                                            double *output, int frames,
+                                            ChannelLayout layout) {
+  const int coefficientsCount = coefficients.size();
+  const int blockChannels = block.channelsCount;
+
+  // distance between samples of adjacent channels and adjacent frames
+  const int channelStride =
+      layout == ChannelLayout::interleaved ? 1 : frames;
+  const int frameStride = layout == ChannelLayout::interleaved ? channels : 1;
+
+  int position = block.delayLinePosition;
+  for (int i = 0; i < frames; i++) {
+    const int offset = i * frameStride + block.firstChannel * channelStride;
+
+    position = position == 0 ? coefficientsCount - 1 : position - 1;
+    double *frame = &block.delayLine[position * blockChannels];
+    double *frameCopy =
+        &block.delayLine[(position + coefficientsCount) * blockChannels];
+    for (int ch = 0; ch < blockChannels; ch++) {
+      frame[ch] = input[offset + ch * channelStride];
+      frameCopy[ch] = frame[ch];
+    }
+
+    if (layout == ChannelLayout::interleaved) {
+      simd::interleavedDotProduct(coefficients.data(), coefficientsCount,
+                                  frame, blockChannels, output + offset);
+    } else {
+      simd::interleavedDotProduct(coefficients.data(), coefficientsCount,
+                                  frame, blockChannels, blockOutput.data());
+      for (int ch = 0; ch < blockChannels; ch++) {
+        output[offset + ch * channelStride] = blockOutput[ch];
+      }
+    }
+  }
+  block.delayLinePosition = position;
+}
+
+/**
+ * Filter each channel with its own FIRProcessor,
+ * interleaved channels are processed in chunks of channelChunkSize frames
+ */
+void MultichannelFIRProcessor::processPartitioned(const double *input,
+                                                  double *output, int frames,
+                                                  ChannelLayout layout) {
+  if (layout == ChannelLayout::planar) {
+    for (int ch = 0; ch < channels; ch++) {
+      channelProcessors[ch].process(input + ch * frames, output + ch * frames,
+                                    frames);
+    }
+    return;
+  }
+
+  for (int from = 0; from < frames; from += channelChunkSize) {
+    const int count = min(channelChunkSize, frames - from);
+    for (int ch = 0; ch < channels; ch++) {
+      for (int i = 0; i < count; i++) {
+        channelInput[i] = input[(from + i) * channels + ch];
+      }
+      channelProcessors[ch].process(channelInput.data(), channelOutput.data(),
+                                    count);
+      for (int i = 0; i < count; i++) {
+        output[(from + i) * channels + ch] = channelOutput[i];
+      }
+    }
+  }
+}
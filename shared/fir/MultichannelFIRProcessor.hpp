@@ -0,0 +1,57 @@
+#ifndef MULTICHANNEL_FIR_PROCESSOR_H
+#define MULTICHANNEL_FIR_PROCESSOR_H
+
+#include "../ChannelLayout.hpp"
+#include "FIRFilter.hpp"
+#include "FIRProcessor.hpp"
+#include <vector>
+
+/**
+ * Streaming FIR filter applying the same coefficients to many channels.
+ * Keeps a separate delay line per channel between process() calls.
+ */
+class MultichannelFIRProcessor {
+public:
+  // channels sharing one interleaved delay line
+  static constexpr int channelBlockSize = 16;
+
+  MultichannelFIRProcessor(const std::vector<double> &coefficients,
+                           int channels);
+  MultichannelFIRProcessor(const FIRFilter &filter, int channels);
+
+  void process(const double *input, double *output, int frames,
+               ChannelLayout layout);
+  std::vector<std::vector<double>>
+  process(const std::vector<std::vector<double>> &input);
+  void reset();
+
+  int getChannelsCount() const;
+  bool isPartitioned() const;
+  int getLatency() const;
+
+private:
+  struct ChannelBlock {
+    int firstChannel;
+    int channelsCount;
+    // frames stored twice, see FIRProcessor
+    std::vector<double> delayLine;
+    int delayLinePosition = 0;
+  };
+
+  const std::vector<double> coefficients;
+  const int channels;
+  std::vector<ChannelBlock> channelBlocks;
+  std::vector<double> blockOutput;
+
+  // long filters are convolved per channel in frequency domain
+  std::vector<FIRProcessor> channelProcessors;
+  std::vector<double> channelInput;
+  std::vector<double> channelOutput;
+
+  void processBlock(ChannelBlock &block, const double *input, double *output,
+                    int frames, ChannelLayout layout);
+  void processPartitioned(const double *input, double *output, int frames,
+                          ChannelLayout layout);
+};
+
+#endif
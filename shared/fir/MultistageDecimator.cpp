@@ -0,0 +1,95 @@
+#include "MultistageDecimator.hpp"
+#include "FIRFilter.hpp"
+#include "KaiserWindow.hpp"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Design filters of the plan stages.
+ * Processing doesn't allocate.
+ *
+ * @param plan stages to run, see DecimationPlan::createOptimal()
+ */
+MultistageDecimator::MultistageDecimator(const DecimationPlan &plan) {
+  const KaiserWindow window(plan.getAttenuationDB());
+
+  stages.reserve(plan.getStages().size());
+  for (const auto &stage : plan.getStages()) {
+    const FIRFilter filter(FilterPass::lowPass, stage.cutoffFrequency,
+                           stage.coefficientsCount, window,
+                           stage.inputSamplingRate);
+    stages.emplace_back(filter, stage.factor);
+  }
+
+  buffer.resize(blockSize / stages.front().getFactor() + 1);
+}
+
+int MultistageDecimator::getFactor() const {
+  int factor = 1;
+  for (const auto &stage : stages) {
+    factor *= stage.getFactor();
+  }
+  return factor;
+}
+
+int MultistageDecimator::getStagesCount() const { return stages.size(); }
+
+/**
+ * @param inputCount number of samples passed to the next process() call
+ * @return number of samples the next process() call outputs
+ */
+int MultistageDecimator::getOutputCount(int inputCount) const {
+  int count = inputCount;
+  for (const auto &stage : stages) {
+    count = stage.getOutputCount(count);
+  }
+  return count;
+}
+
+/**
+ * Clear state of all stages as if no samples were processed before
+ */
+void MultistageDecimator::reset() {
+  for (auto &stage : stages) {
+    stage.reset();
+  }
+}
+
+/**
+ * Filter and downsample next block of samples through all stages
+ *
+ * @param input count input samples
+ * @param output buffer for getOutputCount(count) samples, may be the same as
+ * input
+ * @param count number of input samples
+ * @return number of output samples
+ */
+int MultistageDecimator::process(const double *input, double *output,
+                                 int count) {
+  int outputCount = 0;
+  for (int i = 0; i < count; i += blockSize) {
+    int blockCount = stages.front().process(&input[i], buffer.data(),
+                                            min(blockSize, count - i));
+    for (unsigned int s = 1; s < stages.size(); s++) {
+      blockCount = stages[s].process(buffer.data(), buffer.data(), blockCount);
+    }
+    copy(buffer.begin(), buffer.begin() + blockCount, &output[outputCount]);
+    outputCount += blockCount;
+  }
+
+  return outputCount;
+}
+
+/**
+ * Filter and downsample next block of samples through all stages
+ *
+ * @param input input samples
+ * @return decimated samples
+ */
+vector<double> MultistageDecimator::process(const vector<double> &input) {
+  vector<double> output(getOutputCount(input.size()));
+  process(input.data(), output.data(), input.size());
+
+  return output;
+}
@@ -0,0 +1,34 @@
+#ifndef MULTISTAGE_DECIMATOR_H
+#define MULTISTAGE_DECIMATOR_H
+
+#include "DecimationPlan.hpp"
+#include "PolyphaseDecimator.hpp"
+#include <vector>
+
+/**
+ * Streaming decimator running a cascade of PolyphaseDecimator stages.
+ * Keeps the state of every stage between process() calls, so that a
+ * continuous stream can be decimated in arbitrary sized blocks.
+ */
+class MultistageDecimator {
+public:
+  // input samples passed through the cascade at once
+  static constexpr int blockSize = 4096;
+
+  explicit MultistageDecimator(const DecimationPlan &plan);
+
+  int getFactor() const;
+  int getStagesCount() const;
+  int getOutputCount(int inputCount) const;
+
+  int process(const double *input, double *output, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset();
+
+private:
+  std::vector<PolyphaseDecimator> stages;
+  // output of the first stage for a block, later stages work in place
+  std::vector<double> buffer;
+};
+
+#endif
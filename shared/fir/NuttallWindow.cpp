@@ -0,0 +1,23 @@
+#include "NuttallWindow.hpp"
+
+using namespace std;
+
+optional<vector<double>> NuttallWindow::getCacheKey() const {
+  return vector<double>();
+}
+
+/**
+ * Nuttall 4-term window with continuous first derivative.
+ * Expected attenuation -90dB.
+ *
+ * @param windowSize
+ * @return nuttall window multipliers
+ */
+vector<double> NuttallWindow::getCoefficients(int windowSize) const {
+  return getCosineSumCoefficients({0.355768, 0.487396, 0.144232, 0.012604},
+                                  windowSize);
+}
+
+double NuttallWindow::getTransitionWidthFactor() const { return 7.3; }
+
+double NuttallWindow::getAttenuationDB() const { return 90; }
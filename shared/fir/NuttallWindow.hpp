@@ -0,0 +1,16 @@
+#ifndef NUTTALL_WINDOW_H
+#define NUTTALL_WINDOW_H
+
+#include "Window.hpp"
+#include <optional>
+#include <vector>
+
+class NuttallWindow : public Window {
+public:
+  std::optional<std::vector<double>> getCacheKey() const override;
+  std::vector<double> getCoefficients(int windowSize) const override;
+  double getTransitionWidthFactor() const override;
+  double getAttenuationDB() const override;
+};
+
+#endif
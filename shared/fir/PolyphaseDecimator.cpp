@@ -0,0 +1,115 @@
+#include "PolyphaseDecimator.hpp"
+#include "../SIMD.hpp"
+#include "../Sampling.hpp"
+#include "FIRProcessor.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Decimator by factor using the filter as anti-aliasing filter,
+ * see FIRFilter::createAntiAliasingFilter().
+ * Coefficients are scaled to unity gain at DC.
+ *
+ * @param filter low pass filter at the input sampling rate
+ * @param factor decimation factor, keeping every factor-th sample
+ */
+PolyphaseDecimator::PolyphaseDecimator(const FIRFilter &filter, int factor)
+    : PolyphaseDecimator(normalizeGain(filter.getFilterCoefficients()),
+                         factor) {}
+
+/**
+ * Processing doesn't allocate.
+ *
+ * @param coefficients FIR filter coefficients at the input sampling rate
+ * @param factor decimation factor, keeping every factor-th sample
+ */
+PolyphaseDecimator::PolyphaseDecimator(const vector<double> &coefficients,
+                                       int factor)
+    : coefficients{coefficients}, factor{factor} {
+  if (coefficients.empty()) {
+    throw invalid_argument(
+        "PolyphaseDecimator: coefficients must not be empty");
+  }
+  if (factor < 1) {
+    throw invalid_argument("PolyphaseDecimator: factor must be >= 1");
+  }
+
+  delayLine.resize(2 * coefficients.size(), 0);
+  symmetric = FIRProcessor::isSymmetric(coefficients);
+}
+
+int PolyphaseDecimator::getFactor() const { return factor; }
+
+/**
+ * @param inputCount number of samples passed to the next process() call
+ * @return number of samples the next process() call outputs
+ */
+int PolyphaseDecimator::getOutputCount(int inputCount) const {
+  // the first output is at (factor - phase) % factor input sample
+  const int first = (factor - phase) % factor;
+  return first < inputCount ? (inputCount - 1 - first) / factor + 1 : 0;
+}
+
+/**
+ * Clear filter state as if no samples were processed before
+ */
+void PolyphaseDecimator::reset() {
+  fill(delayLine.begin(), delayLine.end(), 0);
+  delayLinePosition = 0;
+  phase = 0;
+}
+
+/**
+ * Filter and downsample next block of samples.
+ * Vout[m] = c[0] * Vin[m*factor] + ... + c[k] * Vin[m*factor-k]
+ *
+ * Same as running the factor polyphase branches of the filter: input
+ * samples are only stored, filter is evaluated for the kept samples only,
+ * so the work is coefficientsCount / factor multiplications per input sample.
+ *
+ * @param input count input samples
+ * @param output buffer for getOutputCount(count) samples, may be the same as
+ * input
+ * @param count number of input samples
+ * @return number of output samples
+ */
+int PolyphaseDecimator::process(const double *input, double *output,
+                                int count) {
+  const int coefficientsCount = coefficients.size();
+  int outputCount = 0;
+
+  for (int i = 0; i < count; i++) {
+    delayLinePosition =
+        delayLinePosition == 0 ? coefficientsCount - 1 : delayLinePosition - 1;
+    delayLine[delayLinePosition] = input[i];
+    delayLine[delayLinePosition + coefficientsCount] = input[i];
+
+    if (phase == 0) {
+      // delayLine[delayLinePosition + k] is Vin[n-k]
+      const double *history = &delayLine[delayLinePosition];
+      output[outputCount++] =
+          symmetric ? simd::symmetricDotProduct(coefficients.data(), history,
+                                                coefficientsCount)
+                    : simd::dotProduct(coefficients.data(), history,
+                                       coefficientsCount);
+    }
+    phase = phase + 1 == factor ? 0 : phase + 1;
+  }
+
+  return outputCount;
+}
+
+/**
+ * Filter and downsample next block of samples
+ *
+ * @param input input samples
+ * @return decimated samples
+ */
+vector<double> PolyphaseDecimator::process(const vector<double> &input) {
+  vector<double> output(getOutputCount(input.size()));
+  process(input.data(), output.data(), input.size());
+
+  return output;
+}
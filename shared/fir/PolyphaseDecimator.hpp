@@ -0,0 +1,39 @@
+#ifndef POLYPHASE_DECIMATOR_H
+#define POLYPHASE_DECIMATOR_H
+
+#include "FIRFilter.hpp"
+#include <vector>
+
+/**
+ * Streaming low pass filter and downsampler by an integer factor.
+ * Only every factor-th output is calculated.
+ * Keeps delay line between process() calls, so that a continuous stream
+ * can be decimated in arbitrary sized blocks.
+ */
+class PolyphaseDecimator {
+public:
+  PolyphaseDecimator(const FIRFilter &filter, int factor);
+  PolyphaseDecimator(const std::vector<double> &coefficients, int factor);
+
+  int getFactor() const;
+  int getOutputCount(int inputCount) const;
+
+  int process(const double *input, double *output, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset();
+
+private:
+  const std::vector<double> coefficients;
+  const int factor;
+  // linear phase filters need half the multiplications
+  bool symmetric = false;
+
+  // input samples are stored twice,
+  // so that the last coefficientsCount samples are always contiguous
+  std::vector<double> delayLine;
+  int delayLinePosition = 0;
+  // input samples until the next output
+  int phase = 0;
+};
+
+#endif
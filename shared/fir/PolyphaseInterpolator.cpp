@@ -0,0 +1,108 @@
+#include "PolyphaseInterpolator.hpp"
+#include "../SIMD.hpp"
+#include "../Sampling.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Interpolator by factor using the filter as anti-imaging filter,
+ * see FIRFilter::createAntiAliasingFilter().
+ * Coefficients are scaled to unity gain at DC.
+ *
+ * @param filter low pass filter at the output sampling rate
+ * @param factor interpolation factor, number of outputs per input sample
+ */
+PolyphaseInterpolator::PolyphaseInterpolator(const FIRFilter &filter,
+                                             int factor)
+    : PolyphaseInterpolator(normalizeGain(filter.getFilterCoefficients()),
+                            factor) {}
+
+/**
+ * Filter is split into factor branches:
+ * branch[p][j] = factor * c[j*factor + p]
+ * Coefficients are scaled by factor to keep the pass band gain, which is
+ * divided by factor with the inserted zeros. Processing doesn't allocate.
+ *
+ * @param coefficients FIR filter coefficients at the output sampling rate
+ * @param factor interpolation factor, number of outputs per input sample
+ */
+PolyphaseInterpolator::PolyphaseInterpolator(
+    const vector<double> &coefficients, int factor)
+    : factor{factor} {
+  if (coefficients.empty()) {
+    throw invalid_argument(
+        "PolyphaseInterpolator: coefficients must not be empty");
+  }
+  if (factor < 1) {
+    throw invalid_argument("PolyphaseInterpolator: factor must be >= 1");
+  }
+
+  const int coefficientsCount = coefficients.size();
+  branchSize = (coefficientsCount + factor - 1) / factor;
+  branches.resize(factor * branchSize, 0);
+  for (int p = 0; p < factor; p++) {
+    for (int j = 0; j < branchSize; j++) {
+      const int index = j * factor + p;
+      if (index < coefficientsCount) {
+        branches[p * branchSize + j] = factor * coefficients[index];
+      }
+    }
+  }
+
+  delayLine.resize(2 * branchSize, 0);
+}
+
+int PolyphaseInterpolator::getFactor() const { return factor; }
+
+/**
+ * @return number of coefficients per output sample
+ */
+int PolyphaseInterpolator::getBranchSize() const { return branchSize; }
+
+/**
+ * Clear filter state as if no samples were processed before
+ */
+void PolyphaseInterpolator::reset() {
+  fill(delayLine.begin(), delayLine.end(), 0);
+  delayLinePosition = 0;
+}
+
+/**
+ * Upsample and filter next block of samples.
+ * Vout[m*factor + p] = branch[p][0] * Vin[m] + ... + branch[p][j] * Vin[m-j]
+ *
+ * @param input count input samples
+ * @param output buffer for count * factor samples, must not overlap input
+ * @param count number of input samples
+ */
+void PolyphaseInterpolator::process(const double *input, double *output,
+                                    int count) {
+  for (int i = 0; i < count; i++) {
+    delayLinePosition =
+        delayLinePosition == 0 ? branchSize - 1 : delayLinePosition - 1;
+    delayLine[delayLinePosition] = input[i];
+    delayLine[delayLinePosition + branchSize] = input[i];
+
+    // delayLine[delayLinePosition + j] is Vin[m-j]
+    const double *history = &delayLine[delayLinePosition];
+    for (int p = 0; p < factor; p++) {
+      output[i * factor + p] =
+          simd::dotProduct(&branches[p * branchSize], history, branchSize);
+    }
+  }
+}
+
+/**
+ * Upsample and filter next block of samples
+ *
+ * @param input input samples
+ * @return interpolated samples, factor per input sample
+ */
+vector<double> PolyphaseInterpolator::process(const vector<double> &input) {
+  vector<double> output(input.size() * factor);
+  process(input.data(), output.data(), input.size());
+
+  return output;
+}
@@ -0,0 +1,38 @@
+#ifndef POLYPHASE_INTERPOLATOR_H
+#define POLYPHASE_INTERPOLATOR_H
+
+#include "FIRFilter.hpp"
+#include <vector>
+
+/**
+ * Streaming upsampler by an integer factor followed by a low pass filter.
+ * Zeros inserted between input samples are never multiplied, each output
+ * sample is calculated with one polyphase branch of the filter.
+ * Keeps delay line between process() calls, so that a continuous stream
+ * can be interpolated in arbitrary sized blocks.
+ */
+class PolyphaseInterpolator {
+public:
+  PolyphaseInterpolator(const FIRFilter &filter, int factor);
+  PolyphaseInterpolator(const std::vector<double> &coefficients, int factor);
+
+  int getFactor() const;
+  int getBranchSize() const;
+
+  void process(const double *input, double *output, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset();
+
+private:
+  const int factor;
+  int branchSize;
+  // factor branches of branchSize coefficients each
+  std::vector<double> branches;
+
+  // input samples are stored twice,
+  // so that the last branchSize samples are always contiguous
+  std::vector<double> delayLine;
+  int delayLinePosition = 0;
+};
+
+#endif
@@ -0,0 +1,262 @@
+#include "PolyphaseResampler.hpp"
+#include "../SIMD.hpp"
+#include "../Sampling.hpp"
+#include "FIRFilter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Resampler between integer sampling rates.
+ * Rates ratio is reduced to L/M, conversion is exact if L is up to
+ * maxRationalPhasesCount, otherwise it's done as for an arbitrary ratio.
+ *
+ * @param window window to design the prototype low pass filter with
+ * @param transitionLength distance from cutoff to stop band (Hz), stop band
+ * starts at the Nyquist frequency of the lower rate
+ */
+PolyphaseResampler::PolyphaseResampler(int inputSamplingRate,
+                                       int outputSamplingRate,
+                                       const Window &window,
+                                       int transitionLength) {
+  if (inputSamplingRate < 1 || outputSamplingRate < 1) {
+    throw invalid_argument(
+        "PolyphaseResampler: sampling rates must be >= 1");
+  }
+
+  const int divisor = gcd(inputSamplingRate, outputSamplingRate);
+  ratio = static_cast<double>(outputSamplingRate) / inputSamplingRate;
+  if (outputSamplingRate / divisor <= maxRationalPhasesCount) {
+    interpolationFactor = outputSamplingRate / divisor;
+    decimationFactor = inputSamplingRate / divisor;
+    phasesCount = interpolationFactor;
+  } else {
+    phasesCount = defaultPhasesCount;
+  }
+
+  designBranches(inputSamplingRate, outputSamplingRate, window,
+                 transitionLength);
+}
+
+/**
+ * Resampler by an arbitrary ratio.
+ * Filter is tabulated at phasesCount positions between input samples,
+ * coefficients in between are linearly interpolated.
+ *
+ * @param ratio output sampling rate / input sampling rate
+ * @param window window to design the prototype low pass filter with
+ * @param transitionLength distance from cutoff to stop band (Hz), stop band
+ * starts at the Nyquist frequency of the lower rate
+ * @param phasesCount number of tabulated phases
+ */
+PolyphaseResampler::PolyphaseResampler(int inputSamplingRate, double ratio,
+                                       const Window &window,
+                                       int transitionLength, int phasesCount)
+    : ratio{ratio}, phasesCount{phasesCount} {
+  if (inputSamplingRate < 1) {
+    throw invalid_argument("PolyphaseResampler: sampling rate must be >= 1");
+  }
+  if (!(ratio > 0)) {
+    throw invalid_argument("PolyphaseResampler: ratio must be > 0");
+  }
+  if (phasesCount < 1) {
+    throw invalid_argument("PolyphaseResampler: phasesCount must be >= 1");
+  }
+
+  designBranches(inputSamplingRate, inputSamplingRate * ratio, window,
+                 transitionLength);
+}
+
+/**
+ * Design prototype low pass filter at phasesCount times the input rate
+ * and split it into branches:
+ * branch[p][j] = phasesCount * h[j*phasesCount + p]
+ *
+ * Each output takes branchSize coefficients, which depends on the
+ * transition band relative to the input rate only, not on the ratio.
+ */
+void PolyphaseResampler::designBranches(int inputSamplingRate,
+                                        double outputSamplingRate,
+                                        const Window &window,
+                                        int transitionLength) {
+  const int64_t prototypeSamplingRate =
+      static_cast<int64_t>(phasesCount) * inputSamplingRate;
+  if (prototypeSamplingRate > numeric_limits<int>::max()) {
+    throw invalid_argument(
+        "PolyphaseResampler: too many phases for the sampling rate");
+  }
+
+  const int cutoffFrequency =
+      floor(min<double>(inputSamplingRate, outputSamplingRate) / 2) -
+      transitionLength;
+  if (cutoffFrequency < 1) {
+    throw invalid_argument("PolyphaseResampler: transitionLength must be less "
+                           "than Nyquist frequency of the lower rate");
+  }
+
+  const FIRFilter prototype(
+      FilterPass::lowPass, cutoffFrequency,
+      FIRFilter::getOptimalCoefficientsCount(prototypeSamplingRate, window,
+                                             transitionLength),
+      window, prototypeSamplingRate);
+  const auto coefficients = normalizeGain(prototype.getFilterCoefficients());
+
+  prototypeSize = coefficients.size();
+  branchSize = (prototypeSize + phasesCount - 1) / phasesCount;
+  branches.resize((phasesCount + 1) * branchSize, 0);
+  for (int p = 0; p <= phasesCount; p++) {
+    for (int j = 0; j < branchSize; j++) {
+      const int index = j * phasesCount + p;
+      if (index < prototypeSize) {
+        branches[p * branchSize + j] = phasesCount * coefficients[index];
+      }
+    }
+  }
+
+  delayLine.resize(2 * branchSize, 0);
+}
+
+/**
+ * @return true if the conversion is exact by L/M
+ */
+bool PolyphaseResampler::isRational() const { return interpolationFactor > 0; }
+
+/**
+ * @return L of a rational conversion, 0 otherwise
+ */
+int PolyphaseResampler::getInterpolationFactor() const {
+  return interpolationFactor;
+}
+
+/**
+ * @return M of a rational conversion, 0 otherwise
+ */
+int PolyphaseResampler::getDecimationFactor() const { return decimationFactor; }
+
+/**
+ * @return output sampling rate / input sampling rate
+ */
+double PolyphaseResampler::getRatio() const { return ratio; }
+
+int PolyphaseResampler::getPhasesCount() const { return phasesCount; }
+
+/**
+ * @return number of coefficients per output sample (twice as many
+ * multiplications for arbitrary ratio)
+ */
+int PolyphaseResampler::getBranchSize() const { return branchSize; }
+
+/**
+ * @return prototype filter group delay in input samples
+ */
+double PolyphaseResampler::getDelay() const {
+  return (prototypeSize - 1) / (2.0 * phasesCount);
+}
+
+/**
+ * @param inputCount number of samples passed to the next process() call
+ * @return max number of samples the next process() call outputs
+ */
+int PolyphaseResampler::getMaxOutputCount(int inputCount) const {
+  if (isRational()) {
+    // outputs at rationalPosition + n * M < L * inputCount
+    const int64_t end =
+        static_cast<int64_t>(interpolationFactor) * inputCount;
+    return rationalPosition < end ? (end - rationalPosition +
+                                     decimationFactor - 1) /
+                                        decimationFactor
+                                  : 0;
+  }
+  // floating point position may land either side of the last input sample
+  return max(0.0, ceil((inputCount - position) * ratio)) + 1;
+}
+
+/**
+ * Clear filter state as if no samples were processed before
+ */
+void PolyphaseResampler::reset() {
+  fill(delayLine.begin(), delayLine.end(), 0);
+  delayLinePosition = 0;
+  rationalPosition = 0;
+  position = 0;
+}
+
+void PolyphaseResampler::pushSample(double sample) {
+  delayLinePosition =
+      delayLinePosition == 0 ? branchSize - 1 : delayLinePosition - 1;
+  delayLine[delayLinePosition] = sample;
+  delayLine[delayLinePosition + branchSize] = sample;
+}
+
+/**
+ * Vout = branch[p][0] * Vin[n] + ... + branch[p][j] * Vin[n-j]
+ */
+double PolyphaseResampler::calculateOutput(int phase) const {
+  // delayLine[delayLinePosition + j] is Vin[n-j]
+  return simd::dotProduct(&branches[phase * branchSize],
+                          &delayLine[delayLinePosition], branchSize);
+}
+
+/**
+ * Resample next block of samples.
+ *
+ * Output sample at position t (in input samples) after the latest input
+ * sample n is filtered with the branch of phase t * phasesCount.
+ * Arbitrary ratio positions fall between two phases,
+ * outputs of both are linearly interpolated.
+ *
+ * @param input count input samples
+ * @param output buffer for getMaxOutputCount(count) samples, must not
+ * overlap input
+ * @param count number of input samples
+ * @return number of output samples
+ */
+int PolyphaseResampler::process(const double *input, double *output,
+                                int count) {
+  int outputCount = 0;
+
+  if (isRational()) {
+    for (int i = 0; i < count; i++) {
+      pushSample(input[i]);
+      // rationalPosition is relative to the pushed sample now
+      while (rationalPosition < interpolationFactor) {
+        output[outputCount++] = calculateOutput(rationalPosition);
+        rationalPosition += decimationFactor;
+      }
+      rationalPosition -= interpolationFactor;
+    }
+    return outputCount;
+  }
+
+  const double step = 1 / ratio;
+  for (int i = 0; i < count; i++) {
+    pushSample(input[i]);
+    while (position < 1) {
+      const double phase = position * phasesCount;
+      const int branch = min(static_cast<int>(phase), phasesCount - 1);
+      const double fraction = phase - branch;
+      output[outputCount++] = calculateOutput(branch) * (1 - fraction) +
+                              calculateOutput(branch + 1) * fraction;
+      position += step;
+    }
+    position -= 1;
+  }
+  return outputCount;
+}
+
+/**
+ * Resample next block of samples
+ *
+ * @param input input samples
+ * @return resampled samples
+ */
+vector<double> PolyphaseResampler::process(const vector<double> &input) {
+  vector<double> output(getMaxOutputCount(input.size()));
+  output.resize(process(input.data(), output.data(), input.size()));
+
+  return output;
+}
@@ -0,0 +1,66 @@
+#ifndef POLYPHASE_RESAMPLER_H
+#define POLYPHASE_RESAMPLER_H
+
+#include "Window.hpp"
+#include <vector>
+
+/**
+ * Streaming sampling rate converter by a rational L/M or an arbitrary ratio.
+ * Keeps delay line and output phase between process() calls, so that a
+ * continuous stream can be resampled in arbitrary sized blocks.
+ */
+class PolyphaseResampler {
+public:
+  // exact rational conversion up to this interpolation factor
+  static constexpr int maxRationalPhasesCount = 1024;
+  // phases of arbitrary ratio conversion, interpolated in between
+  static constexpr int defaultPhasesCount = 256;
+
+  PolyphaseResampler(int inputSamplingRate, int outputSamplingRate,
+                     const Window &window, int transitionLength);
+  PolyphaseResampler(int inputSamplingRate, double ratio, const Window &window,
+                     int transitionLength,
+                     int phasesCount = defaultPhasesCount);
+
+  bool isRational() const;
+  int getInterpolationFactor() const;
+  int getDecimationFactor() const;
+  double getRatio() const;
+  int getPhasesCount() const;
+  int getBranchSize() const;
+  double getDelay() const;
+  int getMaxOutputCount(int inputCount) const;
+
+  int process(const double *input, double *output, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset();
+
+private:
+  double ratio;
+  // L and M of a rational conversion, 0 otherwise
+  int interpolationFactor = 0;
+  int decimationFactor = 0;
+  int phasesCount;
+  int branchSize;
+  int prototypeSize;
+  // phasesCount + 1 branches of branchSize coefficients each,
+  // the last one is the first one advanced by an input sample
+  std::vector<double> branches;
+
+  // input samples are stored twice,
+  // so that the last branchSize samples are always contiguous
+  std::vector<double> delayLine;
+  int delayLinePosition = 0;
+  // next output position relative to the next input sample,
+  // in 1/L of input sample for rational conversion
+  int rationalPosition = 0;
+  // in input samples otherwise
+  double position = 0;
+
+  void designBranches(int inputSamplingRate, double outputSamplingRate,
+                      const Window &window, int transitionLength);
+  void pushSample(double sample);
+  double calculateOutput(int phase) const;
+};
+
+#endif
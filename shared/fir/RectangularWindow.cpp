@@ -2,6 +2,10 @@
 
 using namespace std;
 
+optional<vector<double>> RectangularWindow::getCacheKey() const {
+  return vector<double>();
+}
+
 /**
  * Rectangular window.
  * Basic window of 1's that doesn't alter coefficients.
@@ -15,11 +19,9 @@ vector<double> RectangularWindow::getCoefficients(int windowSize) const {
     throw invalid_argument("getCoefficients: windowSize must be >= 1");
   }
 
-  vector<double> coefficients;
+  return vector<double>(windowSize, 1);
+}
 
-  for (int i = 0; i < windowSize; i++) {
-    coefficients.push_back(1);
-  }
+double RectangularWindow::getTransitionWidthFactor() const { return 0.9; }
 
-  return coefficients;
-}
+double RectangularWindow::getAttenuationDB() const { return 21; }
@@ -2,11 +2,15 @@
 #define RECTANGULAR_WINDOW_H
 
 #include "Window.hpp"
+#include <optional>
 #include <vector>
 
 class RectangularWindow : public Window {
 public:
+  std::optional<std::vector<double>> getCacheKey() const override;
   std::vector<double> getCoefficients(int windowSize) const override;
+  double getTransitionWidthFactor() const override;
+  double getAttenuationDB() const override;
 };
 
 #endif
\ No newline at end of file
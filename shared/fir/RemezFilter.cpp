@@ -0,0 +1,481 @@
+#include "RemezFilter.hpp"
+#include "../FFT.hpp"
+#include "../Sampling.hpp"
+#include "FIRResponse.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+// dense grid points per extremal
+constexpr int gridDensity = 16;
+constexpr int maxIterationsCount = 100;
+// max error must be this close to the ripple of the current solution
+constexpr double convergenceTolerance = 1e-6;
+
+/**
+ * Approximation problem on a dense frequency grid:
+ * find P minimizing max |weight * (desired - P(cos(2*pi*f)))|
+ */
+struct Grid {
+  vector<double> x;
+  vector<double> desired;
+  vector<double> weights;
+  vector<int> bands;
+};
+
+/**
+ * Lagrange interpolation through extremal points in barycentric form
+ */
+class BarycentricInterpolation {
+public:
+  BarycentricInterpolation(const vector<double> &x, const vector<double> &values,
+                           const vector<double> &weights)
+      : x{x}, values{values}, weights{weights} {}
+
+  double operator()(double at) const {
+    double numerator = 0;
+    double denominator = 0;
+    for (unsigned int k = 0; k < x.size(); k++) {
+      const double distance = at - x[k];
+      if (distance == 0) {
+        return values[k];
+      }
+      const double term = weights[k] / distance;
+      numerator += term * values[k];
+      denominator += term;
+    }
+    return numerator / denominator;
+  }
+
+private:
+  vector<double> x;
+  vector<double> values;
+  vector<double> weights;
+};
+
+/**
+ * 1 / prod(x[k] - x[j]) for all j != k, scaled by a common factor.
+ * Products are accumulated as logarithms, they over- or underflow
+ * for a few hundred points otherwise.
+ */
+vector<double> barycentricWeights(const vector<double> &x) {
+  const int size = x.size();
+  vector<double> logarithms(size, 0);
+  vector<double> signs(size, 1);
+  for (int k = 0; k < size; k++) {
+    for (int j = 0; j < size; j++) {
+      if (j == k) {
+        continue;
+      }
+      const double difference = x[k] - x[j];
+      logarithms[k] -= log(abs(difference));
+      if (difference < 0) {
+        signs[k] = -signs[k];
+      }
+    }
+  }
+
+  const double maxLogarithm =
+      *max_element(logarithms.begin(), logarithms.end());
+  vector<double> weights;
+  weights.reserve(size);
+  for (int k = 0; k < size; k++) {
+    weights.push_back(signs[k] * exp(logarithms[k] - maxLogarithm));
+  }
+  return weights;
+}
+
+/**
+ * Local extrema of the error with alternating signs, the largest one of
+ * adjacent extrema of the same sign is kept
+ */
+vector<int> findExtrema(const vector<double> &error, const vector<int> &bands) {
+  const int size = error.size();
+  vector<int> extrema;
+  for (int i = 0; i < size; i++) {
+    const double e = error[i];
+    if (e == 0) {
+      continue;
+    }
+    auto notExceeded = [&](int neighbour) {
+      return neighbour < 0 || neighbour >= size ||
+             bands[neighbour] != bands[i] ||
+             (e > 0 ? e >= error[neighbour] : e <= error[neighbour]);
+    };
+    if (!notExceeded(i - 1) || !notExceeded(i + 1)) {
+      continue;
+    }
+
+    if (!extrema.empty() && (error[extrema.back()] > 0) == (e > 0)) {
+      if (abs(e) > abs(error[extrema.back()])) {
+        extrema.back() = i;
+      }
+    } else {
+      extrema.push_back(i);
+    }
+  }
+  return extrema;
+}
+
+/**
+ * Drop the smallest extrema keeping signs alternating
+ */
+void reduceExtrema(vector<int> &extrema, const vector<double> &error,
+                   int count) {
+  while (static_cast<int>(extrema.size()) > count) {
+    if (static_cast<int>(extrema.size()) == count + 1) {
+      // dropping an end keeps the alternation
+      if (abs(error[extrema.front()]) < abs(error[extrema.back()])) {
+        extrema.erase(extrema.begin());
+      } else {
+        extrema.pop_back();
+      }
+      continue;
+    }
+
+    auto smallest = min_element(
+        extrema.begin(), extrema.end(),
+        [&](int a, int b) { return abs(error[a]) < abs(error[b]); });
+    const int position = distance(extrema.begin(), smallest);
+    extrema.erase(smallest);
+
+    // neighbours of the removed extremum have the same sign now
+    if (position > 0 && position < static_cast<int>(extrema.size())) {
+      const int left = extrema[position - 1];
+      const int right = extrema[position];
+      extrema.erase(extrema.begin() +
+                    (abs(error[left]) < abs(error[right]) ? position - 1
+                                                          : position));
+    }
+  }
+}
+
+} // namespace
+
+/**
+ * Equiripple FIR filter.
+ *
+ * Pass band and stop band are separated by a transition band of
+ * 2 * transitionLength centered at the cutoff frequency, same as for
+ * the window method. Pass band ripple and stop band attenuation set the
+ * relative weights of the bands, the largest error is minimized.
+ *
+ * Odd number of coefficients gives a type I filter, even - type II,
+ * which is always 0 at samplingRate/2 and can't be a high pass filter.
+ *
+ * @param transitionLength distance from cutoff to pass and stop bands (Hz)
+ * @param attenuationDB stop band attenuation (dB)
+ * @param passBandRippleDB pass band peak-to-peak ripple (dB)
+ * @param isCancelled stops the exchange before convergence, the filter is then
+ * designed from the last trial extrema
+ */
+RemezFilter::RemezFilter(FilterPass passType, int cutoffFrequency,
+                         int transitionLength, double attenuationDB,
+                         int coefficientsCount, int samplingRate,
+                         double passBandRippleDB,
+                         const CancellationCheck &isCancelled)
+    : passType{passType}, cutoffFrequency{cutoffFrequency},
+      samplingRate{samplingRate} {
+  if (samplingRate < 1) {
+    throw invalid_argument("RemezFilter: samplingRate must be >= 1");
+  }
+  if (transitionLength < 1) {
+    throw invalid_argument("RemezFilter: transitionLength must be >= 1");
+  }
+  if (cutoffFrequency - transitionLength <= 0 ||
+      cutoffFrequency + transitionLength >= nyquistFrequency(samplingRate)) {
+    throw invalid_argument("RemezFilter: transition band must be within "
+                           "(0, samplingRate/2)");
+  }
+  if (coefficientsCount < 3) {
+    throw invalid_argument("RemezFilter: coefficientsCount must be >= 3");
+  }
+  if (passType == FilterPass::highPass && coefficientsCount % 2 == 0) {
+    throw invalid_argument(
+        "RemezFilter: high pass filter needs odd number of coefficients");
+  }
+  if (attenuationDB <= 0 || passBandRippleDB <= 0) {
+    throw invalid_argument(
+        "RemezFilter: attenuationDB and passBandRippleDB must be > 0");
+  }
+
+  const double passBandRippleGain = pow(10, passBandRippleDB / 20);
+  const double passBandRipple =
+      (passBandRippleGain - 1) / (passBandRippleGain + 1);
+  const double stopBandRipple = pow(10, -attenuationDB / 20);
+
+  const double lowerEdge =
+      static_cast<double>(cutoffFrequency - transitionLength) / samplingRate;
+  const double upperEdge =
+      static_cast<double>(cutoffFrequency + transitionLength) / samplingRate;
+
+  filterCoefficients = normalize(calculateFilterCoefficients(
+      coefficientsCount, passType == FilterPass::lowPass ? lowerEdge : upperEdge,
+      passType == FilterPass::lowPass ? upperEdge : lowerEdge, passBandRipple,
+      stopBandRipple, isCancelled));
+  // responses on any grid are relative to the same peak
+  peakMagnitude = firPeakMagnitude(filterCoefficients);
+}
+
+int RemezFilter::getCutoffFrequency() const { return cutoffFrequency; }
+
+FilterPass RemezFilter::getPassType() const { return passType; }
+
+int RemezFilter::getSamplingRate() const { return samplingRate; }
+
+vector<double> RemezFilter::getFilterCoefficients() const {
+  return filterCoefficients;
+}
+
+/**
+ * @return number of exchange iterations the design took
+ */
+int RemezFilter::getIterationsCount() const { return iterationsCount; }
+
+/**
+ * Parks-McClellan algorithm.
+ *
+ * Linear phase response is A(w) = Q(w) * P(cos(w)), where Q = 1 for odd and
+ * Q = cos(w/2) for even number of coefficients, P is a polynomial of degree
+ * r - 1. Weighted error of the best approximation alternates r + 1 times,
+ * so P is found by interpolating through r + 1 trial extremal frequencies,
+ * which are exchanged for the error extrema until they stop moving.
+ *
+ * @param passBandEdge, stopBandEdge normalized (to sampling rate) band edges
+ * @return filter coefficients, inverse FFT of the found response
+ */
+vector<double> RemezFilter::calculateFilterCoefficients(
+    int coefficientsCount, double passBandEdge, double stopBandEdge,
+    double passBandRipple, double stopBandRipple,
+    const CancellationCheck &isCancelled) {
+  const bool odd = coefficientsCount % 2 == 1;
+  const int r = odd ? (coefficientsCount + 1) / 2 : coefficientsCount / 2;
+  const double spacing = 0.5 / (gridDensity * r);
+
+  // bands as [from, to], desired gain and weight
+  struct Band {
+    double from;
+    double to;
+    double gain;
+    double weight;
+  };
+  const Band passBand{0, passBandEdge, 1, 1};
+  const Band stopBand{stopBandEdge, 0.5, 0, passBandRipple / stopBandRipple};
+  vector<Band> bands;
+  if (passType == FilterPass::lowPass) {
+    bands = {passBand, stopBand};
+  } else {
+    bands = {{0, stopBandEdge, 0, passBandRipple / stopBandRipple},
+             {passBandEdge, 0.5, 1, 1}};
+  }
+
+  Grid grid;
+  for (unsigned int b = 0; b < bands.size(); b++) {
+    double to = bands[b].to;
+    if (!odd && to == 0.5) {
+      // Q(0.5) = 0 for type II filters
+      to -= spacing;
+    }
+    const int pointsCount = max(2, static_cast<int>(ceil(
+                                       (to - bands[b].from) / spacing)) +
+                                       1);
+    for (int i = 0; i < pointsCount; i++) {
+      const double f =
+          bands[b].from + (to - bands[b].from) * i / (pointsCount - 1);
+      const double q = odd ? 1 : cos(numbers::pi * f);
+      grid.x.push_back(cos(2 * numbers::pi * f));
+      grid.desired.push_back(bands[b].gain / q);
+      grid.weights.push_back(bands[b].weight * q);
+      grid.bands.push_back(b);
+    }
+  }
+
+  const int gridSize = grid.x.size();
+  vector<int> extrema;
+  for (int k = 0; k <= r; k++) {
+    extrema.push_back(
+        round(static_cast<double>(k) * (gridSize - 1) / r));
+  }
+
+  vector<double> x;
+  vector<double> values;
+  vector<double> weights;
+  vector<double> error(gridSize);
+  for (iterationsCount = 1; iterationsCount <= maxIterationsCount;
+       iterationsCount++) {
+    x.clear();
+    for (int i : extrema) {
+      x.push_back(grid.x[i]);
+    }
+    const auto allWeights = barycentricWeights(x);
+
+    // ripple of the solution alternating at the trial extrema
+    double numerator = 0;
+    double denominator = 0;
+    for (int k = 0; k <= r; k++) {
+      const double sign = k % 2 == 0 ? 1 : -1;
+      numerator += allWeights[k] * grid.desired[extrema[k]];
+      denominator += sign * allWeights[k] / grid.weights[extrema[k]];
+    }
+    const double ripple = numerator / denominator;
+
+    // P interpolates r of the r + 1 points, the last one is satisfied
+    // by the choice of the ripple
+    values.clear();
+    weights.clear();
+    for (int k = 0; k < r; k++) {
+      const double sign = k % 2 == 0 ? 1 : -1;
+      values.push_back(grid.desired[extrema[k]] -
+                       sign * ripple / grid.weights[extrema[k]]);
+      weights.push_back(allWeights[k] * (x[k] - x[r]));
+    }
+    x.pop_back();
+    const BarycentricInterpolation polynomial(x, values, weights);
+
+    double maxError = 0;
+    for (int i = 0; i < gridSize; i++) {
+      error[i] = grid.weights[i] * (grid.desired[i] - polynomial(grid.x[i]));
+      maxError = max(maxError, abs(error[i]));
+    }
+
+    if (maxError - abs(ripple) <= convergenceTolerance * abs(ripple)) {
+      break;
+    }
+
+    auto newExtrema = findExtrema(error, grid.bands);
+    if (static_cast<int>(newExtrema.size()) < r + 1) {
+      break;
+    }
+    reduceExtrema(newExtrema, error, r + 1);
+    if (newExtrema == extrema || (isCancelled && isCancelled())) {
+      break;
+    }
+    extrema = std::move(newExtrema);
+  }
+  iterationsCount = min(iterationsCount, maxIterationsCount);
+
+  const BarycentricInterpolation polynomial(x, values, weights);
+
+  // h[n] = 1/N * sum(A(w[k]) * cos(w[k] * (n - (N-1)/2))), w[k] = 2*pi*k/N
+  // is the inverse DFT of the linear phase response A(w) * exp(-j*w*(N-1)/2),
+  // which is Hermitian, so half of it is enough
+  const double center = (coefficientsCount - 1) / 2.0;
+  vector<complex<double>> halfResponse(fft::halfSpectrumSize(coefficientsCount));
+  for (unsigned int k = 0; k < halfResponse.size(); k++) {
+    const double w = 2 * numbers::pi * k / coefficientsCount;
+    const double q = odd ? 1 : cos(w / 2);
+    halfResponse[k] = q * polynomial(cos(w)) * polar(1.0, -w * center);
+  }
+
+  auto coefficients = fft::inverseReal(halfResponse, coefficientsCount);
+  for (int n = 0; n <= (coefficientsCount - 1) / 2; n++) {
+    // restore exact symmetry lost to rounding
+    coefficients[n] =
+        (coefficients[n] + coefficients[coefficientsCount - 1 - n]) /
+        (2 * coefficientsCount);
+    coefficients[coefficientsCount - 1 - n] = coefficients[n];
+  }
+
+  return coefficients;
+}
+
+/**
+ * Calculate filter frequency response from 1 to samplingRate / 2
+ *
+ * @return magnitudes (dB) [-Inf, 0] and phase shifts for each frequency
+ */
+vector<FilterResponse> RemezFilter::calculateResponse() const {
+  const int fromFrequency = 1;
+  const int toFrequency = nyquistFrequency(samplingRate);
+
+  return calculateResponse(FrequencyGrid::linear(
+      fromFrequency - 1, toFrequency - 1, toFrequency - fromFrequency + 1));
+}
+
+vector<FilterResponse>
+RemezFilter::calculateResponse(const FrequencyGrid &grid) const {
+  return calculateFrequencyResponse(grid).toFilterResponses();
+}
+
+FrequencyResponse<>
+RemezFilter::calculateFrequencyResponse(const FrequencyGrid &grid) const {
+  return firResponse(filterCoefficients, samplingRate, grid, peakMagnitude);
+}
+
+/**
+ * Herrmann's formula for equiripple filters
+ * N - 1 = D(dp, ds) / transitionWidth - f(dp, ds) * transitionWidth,
+ * where transitionWidth is normalized to the sampling rate
+ *
+ * @return D and f
+ */
+pair<double, double> RemezFilter::getLengthParameters(double attenuationDB,
+                                                      double passBandRippleDB) {
+  const double passBandRippleGain = pow(10, passBandRippleDB / 20);
+  const double logPassBandRipple =
+      log10((passBandRippleGain - 1) / (passBandRippleGain + 1));
+  const double logStopBandRipple = -attenuationDB / 20;
+
+  const double d =
+      (0.005309 * logPassBandRipple * logPassBandRipple +
+       0.07114 * logPassBandRipple - 0.4761) *
+          logStopBandRipple -
+      (0.00266 * logPassBandRipple * logPassBandRipple +
+       0.5941 * logPassBandRipple + 0.4278);
+  const double f =
+      11.01217 + 0.51244 * (logPassBandRipple - logStopBandRipple);
+  return {d, f};
+}
+
+/**
+ * Estimate number of coefficients reaching the attenuation
+ *
+ * @param attenuationDB stop band attenuation (dB)
+ * @param transitionLength distance from cutoff to pass and stop bands (Hz)
+ * @param passBandRippleDB pass band peak-to-peak ripple (dB)
+ * @return odd number of coefficients
+ */
+int RemezFilter::getOptimalCoefficientsCount(int samplingRate,
+                                             double attenuationDB,
+                                             int transitionLength,
+                                             double passBandRippleDB) {
+  if (transitionLength < 1) {
+    throw invalid_argument(
+        "getOptimalCoefficientsCount: transitionLength must be >= 1");
+  }
+  const auto [d, f] = getLengthParameters(attenuationDB, passBandRippleDB);
+  const double transitionWidth = 2.0 * transitionLength / samplingRate;
+
+  int count = ceil(d / transitionWidth - f * transitionWidth) + 1;
+  count = max(count, 3);
+  return count % 2 == 0 ? count + 1 : count;
+}
+
+/**
+ * Estimate transition length for the given number of coefficients,
+ * inverse of getOptimalCoefficientsCount
+ *
+ * @param attenuationDB stop band attenuation (dB)
+ * @param passBandRippleDB pass band peak-to-peak ripple (dB)
+ * @return distance from cutoff to pass and stop bands (Hz)
+ */
+int RemezFilter::getTransitionLength(int samplingRate, double attenuationDB,
+                                     int coefficientsCount,
+                                     double passBandRippleDB) {
+  if (coefficientsCount < 2) {
+    throw invalid_argument(
+        "getTransitionLength: coefficientsCount must be >= 2");
+  }
+  const auto [d, f] = getLengthParameters(attenuationDB, passBandRippleDB);
+
+  // f * w^2 + (N - 1) * w - D = 0
+  const double n = coefficientsCount - 1;
+  const double transitionWidth = (sqrt(n * n + 4 * f * d) - n) / (2 * f);
+  return ceil(transitionWidth * samplingRate / 2);
+}
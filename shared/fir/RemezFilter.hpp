@@ -0,0 +1,65 @@
+#ifndef REMEZ_FILTER_H
+#define REMEZ_FILTER_H
+
+#include "../Filter.hpp"
+#include "../FilterPass.hpp"
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Equiripple FIR filter designed with the Parks-McClellan (Remez exchange)
+ * algorithm
+ */
+class RemezFilter : public Filter {
+public:
+  static constexpr double defaultPassBandRippleDB = 0.1;
+
+  // polled between exchange iterations, the design stops early once it's true
+  using CancellationCheck = std::function<bool()>;
+
+  RemezFilter(FilterPass passType, int cutoffFrequency, int transitionLength,
+              double attenuationDB, int coefficientsCount, int samplingRate,
+              double passBandRippleDB = defaultPassBandRippleDB,
+              const CancellationCheck &isCancelled = nullptr);
+
+  int getCutoffFrequency() const override;
+  FilterPass getPassType() const;
+  int getSamplingRate() const override;
+
+  std::vector<double> getFilterCoefficients() const override;
+  std::vector<FilterResponse> calculateResponse() const override;
+  std::vector<FilterResponse>
+  calculateResponse(const FrequencyGrid &grid) const override;
+  FrequencyResponse<>
+  calculateFrequencyResponse(const FrequencyGrid &grid) const override;
+
+  int getIterationsCount() const;
+
+  static int
+  getOptimalCoefficientsCount(int samplingRate, double attenuationDB,
+                              int transitionLength,
+                              double passBandRippleDB = defaultPassBandRippleDB);
+  static int
+  getTransitionLength(int samplingRate, double attenuationDB,
+                      int coefficientsCount,
+                      double passBandRippleDB = defaultPassBandRippleDB);
+
+private:
+  const FilterPass passType;
+  const int cutoffFrequency;
+  const int samplingRate;
+  std::vector<double> filterCoefficients;
+  double peakMagnitude;
+  int iterationsCount = 0;
+
+  std::vector<double>
+  calculateFilterCoefficients(int coefficientsCount, double passBandEdge,
+                              double stopBandEdge, double passBandRipple,
+                              double stopBandRipple,
+                              const CancellationCheck &isCancelled);
+  static std::pair<double, double>
+  getLengthParameters(double attenuationDB, double passBandRippleDB);
+};
+
+#endif
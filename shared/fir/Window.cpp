@@ -1,6 +1,119 @@
 #include "Window.hpp"
+#include "../LRUCache.hpp"
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <mutex>
+#include <stdexcept>
+#include <typeindex>
 #include <vector>
 
+using namespace std;
+
+namespace {
+
+struct WindowKey {
+  type_index type;
+  vector<double> parameters;
+  int windowSize;
+
+  bool operator==(const WindowKey &other) const = default;
+};
+
+struct WindowKeyHash {
+  size_t operator()(const WindowKey &key) const {
+    size_t seed = key.type.hash_code() * 31 + hash<int>{}(key.windowSize);
+    for (const double &parameter : key.parameters) {
+      seed = seed * 31 + hash<double>{}(parameter);
+    }
+    return seed;
+  }
+};
+
+constexpr int windowsCacheMaxEntries = 64;
+constexpr size_t windowsCacheMaxBytes = 16 * 1024 * 1024;
+
+// window tables shared by all threads, tables are immutable once calculated
+mutex windowsCacheMutex;
+LRUCache<WindowKey, shared_ptr<const vector<double>>, WindowKeyHash>
+    windowsCache{windowsCacheMaxEntries, windowsCacheMaxBytes};
+
+} // namespace
+
+optional<vector<double>> Window::getCacheKey() const { return nullopt; }
+
+/**
+ * Window multipliers calculated once per window type, cache key and size.
+ * Table stays valid after it's evicted from the cache.
+ *
+ * @param windowSize
+ * @return window multipliers
+ */
+shared_ptr<const vector<double>>
+Window::getCachedCoefficients(int windowSize) const {
+  const auto parameters = getCacheKey();
+  if (!parameters) {
+    return make_shared<const vector<double>>(getCoefficients(windowSize));
+  }
+
+  const WindowKey key{typeid(*this), *parameters, windowSize};
+  {
+    lock_guard<mutex> lock(windowsCacheMutex);
+    if (const auto cached = windowsCache.get(key)) {
+      return *cached;
+    }
+  }
+
+  // calculated outside of the lock, so that other windows aren't blocked
+  auto coefficients =
+      make_shared<const vector<double>>(getCoefficients(windowSize));
+
+  lock_guard<mutex> lock(windowsCacheMutex);
+  windowsCache.put(key, coefficients, windowSize * sizeof(double));
+  return coefficients;
+}
+
+/**
+ * Generalized cosine window
+ * W[n] = a0 - a1 * cos(2*pi*n/(N-1)) + a2 * cos(4*pi*n/(N-1)) - ...
+ *
+ * @param weights a0, a1, ...
+ * @param windowSize N
+ * @return window multipliers
+ */
+vector<double> Window::getCosineSumCoefficients(const vector<double> &weights,
+                                                int windowSize) {
+  if (windowSize < 1) {
+    throw invalid_argument("getCoefficients: windowSize must be >= 1");
+  }
+  if (windowSize == 1) {
+    return {1};
+  }
+
+  vector<double> coefficients;
+  coefficients.reserve(windowSize);
+
+  for (int i = 0; i < windowSize; i++) {
+    double value = 0;
+    for (unsigned int k = 0; k < weights.size(); k++) {
+      const double sign = k % 2 == 0 ? 1 : -1;
+      value += sign * weights[k] *
+               cos((2 * numbers::pi * k * i) / (windowSize - 1));
+    }
+    coefficients.push_back(value);
+  }
+
+  return coefficients;
+}
+
+/**
+ * Drop all cached window tables
+ */
+void Window::clearCache() {
+  lock_guard<mutex> lock(windowsCacheMutex);
+  windowsCache.clear();
+}
+
 /**
  * Apply window to given filter coefficients
  * W[n] * C[n]
@@ -8,12 +121,21 @@
  * @param filterCoefficients coefficients to apply window to
  * @return filtered coefficients
  */
-std::vector<double> Window::apply(const std::vector<double> &filterCoefficients) const {
-  auto windowedCoefficients = getCoefficients(filterCoefficients.size());
+vector<double> Window::apply(const vector<double> &filterCoefficients) const {
+  auto windowedCoefficients = filterCoefficients;
+  applyInPlace(windowedCoefficients);
+  return windowedCoefficients;
+}
+
+/**
+ * Apply window to given filter coefficients without allocating a new buffer
+ *
+ * @param filterCoefficients coefficients to multiply by the window
+ */
+void Window::applyInPlace(vector<double> &filterCoefficients) const {
+  const auto window = getCachedCoefficients(filterCoefficients.size());
 
   for (unsigned int i = 0; i < filterCoefficients.size(); i++) {
-    windowedCoefficients[i] = filterCoefficients[i] * windowedCoefficients[i];
+    filterCoefficients[i] *= (*window)[i];
   }
-
-  return windowedCoefficients;
 }
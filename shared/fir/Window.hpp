@@ -1,6 +1,8 @@
 #ifndef WINDOW_H
 #define WINDOW_H
 
+#include <memory>
+#include <optional>
 #include <vector>
 
 class Window {
@@ -8,7 +10,27 @@ public:
   virtual ~Window() {}
 
   virtual std::vector<double> getCoefficients(int windowSize) const = 0;
+  // exact parameters of the window shape, empty for parameterless windows.
+  // Coefficient tables are cached per window type, key and size,
+  // windows without a key are calculated on every use
+  virtual std::optional<std::vector<double>> getCacheKey() const;
+
+  // D in N = D * samplingRate / transitionBandWidth + 1, i.e. width of the
+  // transition band (both sides of the cutoff) in DFT bins of the window
+  virtual double getTransitionWidthFactor() const = 0;
+  // stop band attenuation (dB) of a filter designed with the window
+  virtual double getAttenuationDB() const = 0;
+
+  std::shared_ptr<const std::vector<double>>
+  getCachedCoefficients(int windowSize) const;
   std::vector<double> apply(const std::vector<double> &filterCoefficients) const;
+  void applyInPlace(std::vector<double> &filterCoefficients) const;
+
+  static void clearCache();
+
+protected:
+  static std::vector<double>
+  getCosineSumCoefficients(const std::vector<double> &weights, int windowSize);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,223 @@
+#include "AnalogPrototype.hpp"
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+using complexd = complex<double>;
+constexpr complexd j{0, 1};
+
+/**
+ * Descending Landen sequence of elliptic moduli
+ *
+ * @param k modulus
+ * @param kp complementary modulus sqrt(1 - k^2), passed separately to keep
+ * precision for k close to 1
+ */
+vector<double> landen(double k, double kp) {
+  vector<double> moduli;
+  while (k > 1e-15 && moduli.size() < 16) {
+    k = (1 - kp) / (1 + kp);
+    kp = 2 * sqrt(kp) / (1 + kp);
+    moduli.push_back(k);
+  }
+  return moduli;
+}
+
+double complement(double k) { return sqrt((1 - k) * (1 + k)); }
+
+/**
+ * Complete elliptic integral of the first kind K(k) = pi / (2 * agm(1, k'))
+ *
+ * @param kp complementary modulus
+ */
+double ellipticK(double kp) {
+  double a = 1;
+  double b = kp;
+  while (abs(a - b) > 1e-15 * a) {
+    const double mean = (a + b) / 2;
+    b = sqrt(a * b);
+    a = mean;
+  }
+  return numbers::pi / (2 * a);
+}
+
+/**
+ * Jacobi elliptic functions cd(u*K, k) and sn(u*K, k) of a complex argument
+ * normalized to the quarter period, computed with Landen transformations
+ */
+complexd cde(complexd u, double k) {
+  const auto moduli = landen(k, complement(k));
+  complexd w = cos(u * numbers::pi / 2.0);
+  for (auto it = moduli.rbegin(); it != moduli.rend(); it++) {
+    w = (1 + *it) * w / (1.0 + *it * w * w);
+  }
+  return w;
+}
+
+complexd sne(complexd u, double k, double kp) {
+  const auto moduli = landen(k, kp);
+  complexd w = sin(u * numbers::pi / 2.0);
+  for (auto it = moduli.rbegin(); it != moduli.rend(); it++) {
+    w = (1 + *it) * w / (1.0 + *it * w * w);
+  }
+  return w;
+}
+
+/**
+ * Symmetric remainder in [-y/2, y/2]
+ */
+double symmetricRemainder(double x, double y) {
+  return x - y * round(x / y);
+}
+
+/**
+ * Inverse of sne: u such that sn(u*K, k) = w
+ */
+complexd asne(complexd w, double k) {
+  const auto moduli = landen(k, complement(k));
+  double previous = k;
+  for (double modulus : moduli) {
+    w = w / (1.0 + sqrt(1.0 - w * w * previous * previous)) * 2.0 /
+        (1 + modulus);
+    previous = modulus;
+  }
+  // acde, sn(u) = cd(1 - u)
+  const complexd u = 2.0 / numbers::pi * acos(w);
+  const double ratio = ellipticK(k) / ellipticK(complement(k));
+  return 1.0 - complexd(symmetricRemainder(u.real(), 4),
+                        symmetricRemainder(u.imag(), 2 * ratio));
+}
+
+double epsilon(double db) { return sqrt(pow(10, db / 10) - 1); }
+
+void checkOrder(int order) {
+  if (order < 1) {
+    throw invalid_argument("AnalogPrototype: order must be >= 1");
+  }
+}
+
+} // namespace
+
+/**
+ * Butterworth filter, maximally flat, -3 dB at 1 rad/s.
+ * Poles are evenly spaced on the left half of the unit circle.
+ */
+AnalogPrototype butterworthPrototype(int order) {
+  checkOrder(order);
+
+  AnalogPrototype prototype;
+  for (int k = 1; k <= order / 2; k++) {
+    const double theta = numbers::pi * (2 * k - 1) / (2 * order);
+    prototype.poles.push_back({-sin(theta), cos(theta)});
+  }
+  if (order % 2 == 1) {
+    prototype.poles.push_back(-1);
+  }
+  return prototype;
+}
+
+/**
+ * Chebyshev type I filter, equiripple in the pass band [0, 1] rad/s.
+ * Poles lie on an ellipse, DC gain is at the bottom of the ripple for even
+ * orders.
+ *
+ * @param passBandRippleDB peak-to-peak pass band ripple (dB)
+ */
+AnalogPrototype chebyshevPrototype(int order, double passBandRippleDB) {
+  checkOrder(order);
+  if (passBandRippleDB <= 0) {
+    throw invalid_argument(
+        "chebyshevPrototype: passBandRippleDB must be > 0");
+  }
+
+  const double mu = asinh(1 / epsilon(passBandRippleDB)) / order;
+  AnalogPrototype prototype;
+  for (int k = 1; k <= order / 2; k++) {
+    const double theta = numbers::pi * (2 * k - 1) / (2 * order);
+    prototype.poles.push_back({-sinh(mu) * sin(theta), cosh(mu) * cos(theta)});
+  }
+  if (order % 2 == 1) {
+    prototype.poles.push_back(-sinh(mu));
+  }
+  prototype.gain = order % 2 == 0 ? pow(10, -passBandRippleDB / 20) : 1;
+  return prototype;
+}
+
+/**
+ * Elliptic (Cauer) filter, equiripple in both the pass band [0, 1] rad/s
+ * and the stop band, which starts right where the given order allows.
+ *
+ * Zeros and poles are calculated from Jacobi elliptic functions as in
+ * S. J. Orfanidis, "Lecture Notes on Elliptic Filter Design".
+ *
+ * @param passBandRippleDB peak-to-peak pass band ripple (dB)
+ * @param attenuationDB stop band attenuation (dB)
+ */
+AnalogPrototype ellipticPrototype(int order, double passBandRippleDB,
+                                  double attenuationDB) {
+  checkOrder(order);
+  if (passBandRippleDB <= 0 || attenuationDB <= passBandRippleDB) {
+    throw invalid_argument("ellipticPrototype: expecting 0 < passBandRippleDB "
+                           "< attenuationDB");
+  }
+
+  const double passBandEpsilon = epsilon(passBandRippleDB);
+  const double k1 = passBandEpsilon / epsilon(attenuationDB);
+  const double k1p = complement(k1);
+
+  // degree equation, selectivity k for the given order and ripples
+  double kp = pow(k1p, order);
+  for (int i = 1; i <= order / 2; i++) {
+    kp *= pow(sne((2.0 * i - 1) / order, k1p, k1).real(), 4);
+  }
+  const double k = complement(kp);
+
+  const double v0 =
+      (-j * asne(j / passBandEpsilon, k1) / static_cast<double>(order)).real();
+
+  AnalogPrototype prototype;
+  for (int i = 1; i <= order / 2; i++) {
+    const double u = (2.0 * i - 1) / order;
+    prototype.zeros.push_back(j / (k * cde(u, k)));
+    prototype.poles.push_back(j * cde(u - j * v0, k));
+  }
+  if (order % 2 == 1) {
+    prototype.poles.push_back((j * sne(j * v0, k, kp)).real());
+  }
+  prototype.gain = order % 2 == 0 ? pow(10, -passBandRippleDB / 20) : 1;
+  return prototype;
+}
+
+/**
+ * Minimal order reaching the attenuation at the stop band edge
+ *
+ * @param stopBandEdge stop band edge (rad/s) relative to the pass band edge
+ * at 1 rad/s, which is -3 dB for Butterworth filters
+ * @return fractional order, round it up
+ */
+double getPrototypeOrder(IIRApproximation approximation, double stopBandEdge,
+                         double passBandRippleDB, double attenuationDB) {
+  if (stopBandEdge <= 1) {
+    throw invalid_argument("getPrototypeOrder: stopBandEdge must be > 1");
+  }
+
+  switch (approximation) {
+  case IIRApproximation::butterworth:
+    return log10(pow(10, attenuationDB / 10) - 1) / (2 * log10(stopBandEdge));
+  case IIRApproximation::chebyshev:
+    return acosh(epsilon(attenuationDB) / epsilon(passBandRippleDB)) /
+           acosh(stopBandEdge);
+  case IIRApproximation::elliptic: {
+    // N = K(k) * K'(k1) / (K'(k) * K(k1))
+    const double k = 1 / stopBandEdge;
+    const double k1 = epsilon(passBandRippleDB) / epsilon(attenuationDB);
+    return ellipticK(complement(k)) * ellipticK(k1) /
+           (ellipticK(k) * ellipticK(complement(k1)));
+  }
+  }
+  throw logic_error("Unknown IIR approximation");
+}
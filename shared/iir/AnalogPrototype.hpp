@@ -0,0 +1,30 @@
+#ifndef ANALOG_PROTOTYPE_H
+#define ANALOG_PROTOTYPE_H
+
+#include <complex>
+#include <vector>
+
+enum class IIRApproximation { butterworth, chebyshev, elliptic };
+
+/**
+ * Analog low pass filter with the pass band edge at 1 rad/s, described by
+ * its finite zeros, poles and the gain at DC.
+ * Complex zeros and poles come in conjugate pairs, only the ones with a
+ * positive imaginary part are listed, real poles are listed once.
+ */
+struct AnalogPrototype {
+  std::vector<std::complex<double>> zeros;
+  std::vector<std::complex<double>> poles;
+  double gain = 1;
+};
+
+AnalogPrototype butterworthPrototype(int order);
+AnalogPrototype chebyshevPrototype(int order, double passBandRippleDB);
+AnalogPrototype ellipticPrototype(int order, double passBandRippleDB,
+                                  double attenuationDB);
+
+double getPrototypeOrder(IIRApproximation approximation,
+                         double stopBandEdge, double passBandRippleDB,
+                         double attenuationDB);
+
+#endif
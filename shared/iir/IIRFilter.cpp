@@ -1,6 +1,8 @@
 #include "IIRFilter.hpp"
 #include "../Sampling.hpp"
-#include "Welle.hpp"
+#include "IIRProcessor.hpp"
+#include <complex>
+#include <numbers>
 
 using namespace std;
 
@@ -28,21 +30,56 @@ int IIRFilter::getSamplingRate() const { return samplingRate; }
 /**
  * Calculate IIR filter frequency response from 1 to samplingRate / 2
  *
- * @return magnitudes (dB) [-Inf, 0] and phase shifts [0] for each frequency
+ * @return magnitudes (dB) [-Inf, 0] and phase shifts for each frequency
  */
 vector<FilterResponse> IIRFilter::calculateResponse() const {
   const int fromFrequency = 1;
   const int toFrequency = nyquistFrequency(getSamplingRate());
 
-  vector<FilterResponse> response;
-  auto sine = welle::SineWave<double>(getSamplingRate());
-  const double peakToPeakAmplitude = 2;
-  for (int frequency = fromFrequency; frequency < toFrequency; frequency++) {
-    auto samples = sine.generatePeriod(frequency, peakToPeakAmplitude);
-    auto filteredSamples = apply(samples);
+  return calculateResponse(FrequencyGrid::linear(
+      fromFrequency, toFrequency - 1, toFrequency - fromFrequency));
+}
+
+/**
+ * Calculate IIR filter frequency response at the given frequencies
+ *
+ * @param grid frequencies to evaluate
+ * @return magnitudes (dB) and phase shifts (radians) for each grid frequency
+ */
+vector<FilterResponse>
+IIRFilter::calculateResponse(const FrequencyGrid &grid) const {
+  return calculateFrequencyResponse(grid).toFilterResponses();
+}
+
+/**
+ * Calculate IIR filter frequency response at the given frequencies
+ * directly from the filter transfer function.
+ *
+ * Using coefficients a,b,c returned by getFilterCoefficients() method:
+ * Vout = a * Vin[n] + b * Vin[n-1] + c * Vout[n-1]
+ *
+ * H(z) = (a + b * z^-1) / (1 - c * z^-1), z = e^jw
+ *
+ * @param grid frequencies to evaluate
+ * @return grid frequencies with magnitudes (dB) and phase shifts (radians)
+ */
+FrequencyResponse<>
+IIRFilter::calculateFrequencyResponse(const FrequencyGrid &grid) const {
+  const auto coefficients = getFilterCoefficients();
+  if (coefficients.size() < 3) {
+    throw std::logic_error("Expecting at least 3 IIR filter coefficients");
+  }
 
-    response.push_back(FilterResponse(toDB(maxAbsValue(filteredSamples)),
-                                      phaseShift(samples, filteredSamples)));
+  FrequencyResponse<> response;
+  response.reserve(grid.size());
+  for (const double &frequency : grid.getFrequencies()) {
+    const complex<double> z1 =
+        polar(1.0, -2 * numbers::pi * frequency / getSamplingRate());
+    const complex<double> transferFunction =
+        (coefficients[0] + coefficients[1] * z1) / (1.0 - coefficients[2] * z1);
+
+    response.push_back(frequency, toDB(abs(transferFunction)),
+                       arg(transferFunction));
   }
 
   return response;
@@ -50,6 +87,7 @@ vector<FilterResponse> IIRFilter::calculateResponse() const {
 
 /**
  * Apply filter to a sample buffer.
+ * Use IIRProcessor to filter a continuous stream block by block.
  *
  * Using coefficients a,b,c returned by getFilterCoefficients() method:
  * Vout = a * Vin[n] + b * Vin[n-1] + c * Vout[n-1]
@@ -62,19 +100,13 @@ vector<double> IIRFilter::apply(const vector<double> &samples) const {
     return samples;
   }
 
-  const auto coefficients = getFilterCoefficients();
-  if (coefficients.size() < 3) {
-    throw std::logic_error("Expecting at least 3 IIR filter coefficients");
-  }
+  // history starts from the first sample to avoid a jump at the beginning
+  IIRProcessor processor(*this);
+  processor.reset(samples[0], samples[0]);
 
-  vector<double> result;
-  result.push_back(samples[0]);
-  for (unsigned int i = 1; i < samples.size(); i++) {
-    // Vout = a * Vin[n] - a * Vin[n-1] + a * Vout[n-1]
-    result.push_back(coefficients[0] * samples[i] +
-                     coefficients[1] * samples[i - 1] +
-                     coefficients[2] * result[i - 1]);
-  }
+  vector<double> result(samples.size());
+  result[0] = samples[0];
+  processor.process(samples.data() + 1, result.data() + 1, samples.size() - 1);
 
   return result;
 }
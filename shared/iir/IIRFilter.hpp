@@ -12,7 +12,11 @@ public:
   int getCutoffFrequency() const override;
   int getSamplingRate() const override;
   std::vector<FilterResponse> calculateResponse() const override;
-  std::vector<double> apply(const std::vector<double> &samples) const;
+  std::vector<FilterResponse>
+  calculateResponse(const FrequencyGrid &grid) const override;
+  FrequencyResponse<>
+  calculateFrequencyResponse(const FrequencyGrid &grid) const override;
+  virtual std::vector<double> apply(const std::vector<double> &samples) const;
 
 private:
   const int cutoffFrequency;
@@ -0,0 +1,79 @@
+#include "IIRProcessor.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Streaming IIR filter.
+ * Filter coefficients are read once, processing doesn't allocate.
+ *
+ * @param filter IIR filter to take coefficients from
+ */
+IIRProcessor::IIRProcessor(const IIRFilter &filter) {
+  const auto coefficients = filter.getFilterCoefficients();
+  if (coefficients.size() != 3) {
+    // higher order filters are cascades of sections, see SOSProcessor
+    throw logic_error("Expecting 3 IIR filter coefficients");
+  }
+
+  a = coefficients[0];
+  b = coefficients[1];
+  c = coefficients[2];
+}
+
+/**
+ * Set filter state
+ *
+ * @param previousInput Vin[n-1] for the next processed sample
+ * @param previousOutput Vout[n-1] for the next processed sample
+ */
+void IIRProcessor::reset(double previousInput, double previousOutput) {
+  this->previousInput = previousInput;
+  this->previousOutput = previousOutput;
+}
+
+/**
+ * Filter next block of samples.
+ * Vout = a * Vin[n] + b * Vin[n-1] + c * Vout[n-1]
+ *
+ * @param input count input samples
+ * @param output buffer for count filtered samples, may be the same as input
+ * @param count number of samples
+ */
+void IIRProcessor::process(const double *input, double *output, int count) {
+  double x1 = previousInput;
+  double y1 = previousOutput;
+
+  for (int i = 0; i < count; i++) {
+    const double x = input[i];
+    y1 = a * x + b * x1 + c * y1;
+    x1 = x;
+    output[i] = y1;
+  }
+
+  previousInput = x1;
+  previousOutput = y1;
+}
+
+/**
+ * Filter next block of samples in-place
+ *
+ * @param samples count samples to replace with filtered ones
+ * @param count number of samples
+ */
+void IIRProcessor::process(double *samples, int count) {
+  process(samples, samples, count);
+}
+
+/**
+ * Filter next block of samples
+ *
+ * @param input input samples
+ * @return filtered samples
+ */
+vector<double> IIRProcessor::process(const vector<double> &input) {
+  vector<double> output(input.size());
+  process(input.data(), output.data(), input.size());
+
+  return output;
+}
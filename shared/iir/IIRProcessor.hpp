@@ -0,0 +1,29 @@
+#ifndef IIR_PROCESSOR_H
+#define IIR_PROCESSOR_H
+
+#include "IIRFilter.hpp"
+#include <vector>
+
+/**
+ * Streaming IIR filter.
+ * Keeps previous input and output samples between process() calls, so that a
+ * continuous stream can be filtered in arbitrary sized blocks.
+ */
+class IIRProcessor {
+public:
+  explicit IIRProcessor(const IIRFilter &filter);
+
+  void process(const double *input, double *output, int count);
+  void process(double *samples, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset(double previousInput = 0, double previousOutput = 0);
+
+private:
+  double a;
+  double b;
+  double c;
+  double previousInput = 0;
+  double previousOutput = 0;
+};
+
+#endif
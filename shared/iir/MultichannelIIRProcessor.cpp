@@ -0,0 +1,132 @@
+#include "MultichannelIIRProcessor.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+/**
+ * Streaming IIR filter for many channels.
+ * Filter coefficients are read once, processing doesn't allocate.
+ *
+ * @param filter IIR filter to take coefficients from
+ * @param channels number of channels
+ */
+MultichannelIIRProcessor::MultichannelIIRProcessor(const IIRFilter &filter,
+                                                   int channels)
+    : channels{channels} {
+  if (channels < 1) {
+    throw invalid_argument("MultichannelIIRProcessor: channels must be >= 1");
+  }
+
+  const auto coefficients = filter.getFilterCoefficients();
+  if (coefficients.size() != 3) {
+    // higher order filters are cascades of sections, see SOSProcessor
+    throw logic_error("Expecting 3 IIR filter coefficients");
+  }
+
+  a = coefficients[0];
+  b = coefficients[1];
+  c = coefficients[2];
+
+  previousInput.resize(channels, 0);
+  previousOutput.resize(channels, 0);
+}
+
+int MultichannelIIRProcessor::getChannelsCount() const { return channels; }
+
+/**
+ * Set state of all channels
+ *
+ * @param previousInput Vin[n-1] for the next processed frame
+ * @param previousOutput Vout[n-1] for the next processed frame
+ */
+void MultichannelIIRProcessor::reset(double previousInput,
+                                     double previousOutput) {
+  fill(this->previousInput.begin(), this->previousInput.end(), previousInput);
+  fill(this->previousOutput.begin(), this->previousOutput.end(),
+       previousOutput);
+}
+
+/**
+ * Filter next frames of all channels.
+ * Vout = a * Vin[n] + b * Vin[n-1] + c * Vout[n-1]
+ *
+ * Interleaved frames are filtered one frame at a time, channels of a frame
+ * are independent, so the inner loop over channels is vectorized.
+ * Planar channels are filtered one channel at a time.
+ *
+ * @param input frames * channels samples in the given layout
+ * @param output buffer for frames * channels filtered samples in the same
+ * layout, may be the same as input
+ * @param frames number of samples per channel
+ * @param layout planar or interleaved channels
+ */
+void MultichannelIIRProcessor::process(const double *input, double *output,
+                                       int frames, ChannelLayout layout) {
+  double *x1 = previousInput.data();
+  double *y1 = previousOutput.data();
+
+  if (layout == ChannelLayout::interleaved) {
+    for (int i = 0; i < frames; i++) {
+      const double *inputFrame = input + i * channels;
+      double *outputFrame = output + i * channels;
+      for (int ch = 0; ch < channels; ch++) {
+        const double x = inputFrame[ch];
+        y1[ch] = a * x + b * x1[ch] + c * y1[ch];
+        x1[ch] = x;
+        outputFrame[ch] = y1[ch];
+      }
+    }
+    return;
+  }
+
+  for (int ch = 0; ch < channels; ch++) {
+    const double *channelInput = input + ch * frames;
+    double *channelOutput = output + ch * frames;
+    double x1Channel = x1[ch];
+    double y1Channel = y1[ch];
+    for (int i = 0; i < frames; i++) {
+      const double x = channelInput[i];
+      y1Channel = a * x + b * x1Channel + c * y1Channel;
+      x1Channel = x;
+      channelOutput[i] = y1Channel;
+    }
+    x1[ch] = x1Channel;
+    y1[ch] = y1Channel;
+  }
+}
+
+/**
+ * Filter next samples of all channels
+ *
+ * @param input samples per channel, all channels of the same size
+ * @return filtered samples per channel
+ */
+vector<vector<double>> MultichannelIIRProcessor::process(
+    const vector<vector<double>> &input) {
+  if (static_cast<int>(input.size()) != channels) {
+    throw invalid_argument("MultichannelIIRProcessor: expecting " +
+                           to_string(channels) + " channels");
+  }
+
+  const int frames = input[0].size();
+  vector<double> planar;
+  planar.reserve(frames * channels);
+  for (const auto &samples : input) {
+    if (static_cast<int>(samples.size()) != frames) {
+      throw invalid_argument(
+          "MultichannelIIRProcessor: channels must be of the same size");
+    }
+    planar.insert(planar.end(), samples.begin(), samples.end());
+  }
+
+  process(planar.data(), planar.data(), frames, ChannelLayout::planar);
+
+  vector<vector<double>> output;
+  for (int ch = 0; ch < channels; ch++) {
+    output.emplace_back(planar.begin() + ch * frames,
+                        planar.begin() + (ch + 1) * frames);
+  }
+  return output;
+}
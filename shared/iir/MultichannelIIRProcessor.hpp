@@ -0,0 +1,34 @@
+#ifndef MULTICHANNEL_IIR_PROCESSOR_H
+#define MULTICHANNEL_IIR_PROCESSOR_H
+
+#include "../ChannelLayout.hpp"
+#include "IIRFilter.hpp"
+#include <vector>
+
+/**
+ * Streaming IIR filter applying the same coefficients to many channels.
+ * Keeps previous input and output samples of every channel between process()
+ * calls.
+ */
+class MultichannelIIRProcessor {
+public:
+  MultichannelIIRProcessor(const IIRFilter &filter, int channels);
+
+  void process(const double *input, double *output, int frames,
+               ChannelLayout layout);
+  std::vector<std::vector<double>>
+  process(const std::vector<std::vector<double>> &input);
+  void reset(double previousInput = 0, double previousOutput = 0);
+
+  int getChannelsCount() const;
+
+private:
+  double a;
+  double b;
+  double c;
+  const int channels;
+  std::vector<double> previousInput;
+  std::vector<double> previousOutput;
+};
+
+#endif
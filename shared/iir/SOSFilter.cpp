@@ -0,0 +1,267 @@
+#include "SOSFilter.hpp"
+#include "../Sampling.hpp"
+#include "SOSProcessor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+using complexd = complex<double>;
+
+/**
+ * Pole or zero of a section with its conjugate, or a single real one
+ */
+struct Root {
+  complexd value;
+  bool pair;
+};
+
+/**
+ * Map analog prototype root to the z-plane.
+ * Prototype is scaled to the pre-warped cutoff (and inverted s -> 1/s for a
+ * high pass filter), then bilinear transform s = (z - 1) / (z + 1) is applied.
+ *
+ * @param warpedCutoff tan(pi * cutoffFrequency / samplingRate)
+ */
+complexd bilinear(complexd root, double warpedCutoff, FilterPass passType) {
+  const complexd s = passType == FilterPass::lowPass ? root * warpedCutoff
+                                                     : warpedCutoff / root;
+  return (1.0 + s) / (1.0 - s);
+}
+
+/**
+ * Coefficients of z^-1 and z^-2 of a monic polynomial with the given roots
+ *
+ * @return (-2 * re(r), |r|^2) for a conjugate pair, (-r, 0) for a single
+ * real root, (-(r1 + r2), r1 * r2) for two real roots
+ */
+pair<double, double> polynomial(const vector<Root> &roots) {
+  if (roots.size() == 1 && roots[0].pair) {
+    return {-2 * roots[0].value.real(), norm(roots[0].value)};
+  }
+  if (roots.size() == 1) {
+    return {-roots[0].value.real(), 0};
+  }
+  if (roots.size() == 2) {
+    return {-(roots[0].value.real() + roots[1].value.real()),
+            roots[0].value.real() * roots[1].value.real()};
+  }
+  return {0, 0};
+}
+
+} // namespace
+
+/**
+ * IIR filter designed from an analog prototype with the bilinear transform.
+ * Cutoff frequency is pre-warped, so that it's exact in the digital filter.
+ *
+ * Sections are ordered from the lowest to the highest pole radius, each
+ * pole pair gets the nearest zeros, which keeps the intermediate gains and
+ * round-off noise low. Every section has unity gain in the pass band
+ * (DC for low pass, samplingRate/2 for high pass), the first one also
+ * carries the prototype gain.
+ *
+ * @param order filter order, number of poles
+ * @param cutoffFrequency pass band edge, -3 dB point for Butterworth filters
+ * @param attenuationDB stop band attenuation of elliptic filters (dB)
+ * @param passBandRippleDB pass band ripple of Chebyshev and elliptic filters
+ */
+SOSFilter::SOSFilter(IIRApproximation approximation, FilterPass passType,
+                     int order, int cutoffFrequency, double attenuationDB,
+                     int samplingRate, double passBandRippleDB)
+    : IIRFilter(cutoffFrequency, samplingRate), approximation{approximation},
+      passType{passType}, order{order} {
+  AnalogPrototype prototype;
+  switch (approximation) {
+  case IIRApproximation::butterworth:
+    prototype = butterworthPrototype(order);
+    break;
+  case IIRApproximation::chebyshev:
+    prototype = chebyshevPrototype(order, passBandRippleDB);
+    break;
+  case IIRApproximation::elliptic:
+    prototype = ellipticPrototype(order, passBandRippleDB, attenuationDB);
+    break;
+  }
+
+  const double warpedCutoff =
+      tan(numbers::pi * cutoffFrequency / samplingRate);
+
+  vector<Root> poles;
+  for (const auto &pole : prototype.poles) {
+    poles.push_back({bilinear(pole, warpedCutoff, passType), pole.imag() != 0});
+  }
+  vector<Root> zeros;
+  for (const auto &zero : prototype.zeros) {
+    zeros.push_back({bilinear(zero, warpedCutoff, passType), true});
+  }
+  // zeros at infinity go to samplingRate/2 for low pass and to DC for high pass
+  const double passBandZ = passType == FilterPass::lowPass ? 1 : -1;
+  const int infiniteZerosCount = order - 2 * prototype.zeros.size();
+  vector<Root> realZeros(infiniteZerosCount, Root{-passBandZ, false});
+
+  // real pole goes first, then from the lowest to the highest Q
+  sort(poles.begin(), poles.end(), [](const Root &a, const Root &b) {
+    if (a.pair != b.pair) {
+      return !a.pair;
+    }
+    return abs(a.value) < abs(b.value);
+  });
+
+  vector<vector<Root>> sectionZeros(poles.size());
+  for (int i = poles.size() - 1; i >= 0 && !zeros.empty(); i--) {
+    if (!poles[i].pair) {
+      continue;
+    }
+    auto nearest = min_element(
+        zeros.begin(), zeros.end(), [&](const Root &a, const Root &b) {
+          return abs(a.value - poles[i].value) < abs(b.value - poles[i].value);
+        });
+    sectionZeros[i].push_back(*nearest);
+    zeros.erase(nearest);
+  }
+  for (unsigned int i = 0; i < poles.size(); i++) {
+    if (!sectionZeros[i].empty()) {
+      continue;
+    }
+    const int zerosCount = poles[i].pair ? 2 : 1;
+    for (int z = 0; z < zerosCount && !realZeros.empty(); z++) {
+      sectionZeros[i].push_back(realZeros.back());
+      realZeros.pop_back();
+    }
+  }
+
+  for (unsigned int i = 0; i < poles.size(); i++) {
+    BiquadSection section{1, 0, 0, 0, 0};
+    tie(section.b1, section.b2) = polynomial(sectionZeros[i]);
+    tie(section.a1, section.a2) = polynomial({poles[i]});
+
+    // unity gain in the pass band, z = z^-1 = passBandZ
+    const double gain =
+        (1 + section.b1 * passBandZ + section.b2) /
+        (1 + section.a1 * passBandZ + section.a2);
+    const double scale = (i == 0 ? prototype.gain : 1) / gain;
+    section.b0 *= scale;
+    section.b1 *= scale;
+    section.b2 *= scale;
+    sections.push_back(section);
+  }
+}
+
+IIRApproximation SOSFilter::getApproximation() const { return approximation; }
+
+FilterPass SOSFilter::getPassType() const { return passType; }
+
+int SOSFilter::getOrder() const { return order; }
+
+const vector<BiquadSection> &SOSFilter::getSections() const {
+  return sections;
+}
+
+/**
+ * @return b0, b1, b2, a1, a2 of every section, see getSections()
+ */
+vector<double> SOSFilter::getFilterCoefficients() const {
+  vector<double> coefficients;
+  coefficients.reserve(sections.size() * 5);
+  for (const auto &section : sections) {
+    coefficients.insert(coefficients.end(), {section.b0, section.b1,
+                                             section.b2, section.a1,
+                                             section.a2});
+  }
+  return coefficients;
+}
+
+/**
+ * Calculate frequency response as a product of the section responses
+ *
+ * @param grid frequencies to evaluate
+ * @return grid frequencies with magnitudes (dB) and phase shifts (radians)
+ */
+FrequencyResponse<>
+SOSFilter::calculateFrequencyResponse(const FrequencyGrid &grid) const {
+  FrequencyResponse<> response;
+  response.reserve(grid.size());
+  for (const double &frequency : grid.getFrequencies()) {
+    const complexd z1 =
+        polar(1.0, -2 * numbers::pi * frequency / getSamplingRate());
+    const complexd z2 = z1 * z1;
+    complexd transferFunction = 1;
+    for (const auto &section : sections) {
+      transferFunction *= (section.b0 + section.b1 * z1 + section.b2 * z2) /
+                          (1.0 + section.a1 * z1 + section.a2 * z2);
+    }
+
+    response.push_back(frequency, toDB(abs(transferFunction)),
+                       arg(transferFunction));
+  }
+
+  return response;
+}
+
+/**
+ * Apply filter to a sample buffer.
+ * Use SOSProcessor to filter a continuous stream block by block.
+ *
+ * @param samples input buffer
+ * @return filtered samples
+ */
+vector<double> SOSFilter::apply(const vector<double> &samples) const {
+  if (samples.size() == 0) {
+    return samples;
+  }
+
+  // steady state for the first sample to avoid a jump at the beginning
+  SOSProcessor processor(*this);
+  processor.reset(samples[0]);
+
+  return processor.process(samples);
+}
+
+/**
+ * Estimate minimal filter order reaching the attenuation.
+ * Stop band starts 2 * transitionLength away from the cutoff frequency, so
+ * that the transition band is as wide as the one of FIR filters.
+ *
+ * @param cutoffFrequency pass band edge, -3 dB point for Butterworth filters
+ * @param transitionLength half width of the transition band (Hz)
+ * @param attenuationDB stop band attenuation (dB)
+ * @param passBandRippleDB pass band ripple of Chebyshev and elliptic filters
+ */
+int SOSFilter::getOptimalOrder(IIRApproximation approximation,
+                               FilterPass passType, int cutoffFrequency,
+                               int transitionLength, double attenuationDB,
+                               int samplingRate, double passBandRippleDB) {
+  if (transitionLength < 1) {
+    throw invalid_argument("getOptimalOrder: transitionLength must be >= 1");
+  }
+  const int stopBandFrequency =
+      passType == FilterPass::lowPass ? cutoffFrequency + 2 * transitionLength
+                                      : cutoffFrequency - 2 * transitionLength;
+  if (cutoffFrequency <= 0 || stopBandFrequency <= 0 ||
+      cutoffFrequency >= nyquistFrequency(samplingRate) ||
+      stopBandFrequency >= nyquistFrequency(samplingRate)) {
+    throw invalid_argument(
+        "getOptimalOrder: pass and stop bands must be within "
+        "(0, samplingRate/2)");
+  }
+
+  const double warpedCutoff =
+      tan(numbers::pi * cutoffFrequency / samplingRate);
+  const double warpedStopBand =
+      tan(numbers::pi * stopBandFrequency / samplingRate);
+  const double stopBandEdge = passType == FilterPass::lowPass
+                                  ? warpedStopBand / warpedCutoff
+                                  : warpedCutoff / warpedStopBand;
+
+  const double order = getPrototypeOrder(approximation, stopBandEdge,
+                                         passBandRippleDB, attenuationDB);
+  return max(1, static_cast<int>(ceil(order - 1e-9)));
+}
@@ -0,0 +1,56 @@
+#ifndef SOS_FILTER_H
+#define SOS_FILTER_H
+
+#include "../FilterPass.hpp"
+#include "AnalogPrototype.hpp"
+#include "IIRFilter.hpp"
+#include <vector>
+
+/**
+ * Second order section
+ * H(z) = (b0 + b1 * z^-1 + b2 * z^-2) / (1 + a1 * z^-1 + a2 * z^-2)
+ */
+struct BiquadSection {
+  double b0;
+  double b1;
+  double b2;
+  double a1;
+  double a2;
+};
+
+/**
+ * Order N Butterworth, Chebyshev or elliptic IIR filter as a cascade of
+ * second order sections
+ */
+class SOSFilter : public IIRFilter {
+public:
+  static constexpr double defaultPassBandRippleDB = 0.1;
+
+  SOSFilter(IIRApproximation approximation, FilterPass passType, int order,
+            int cutoffFrequency, double attenuationDB, int samplingRate,
+            double passBandRippleDB = defaultPassBandRippleDB);
+
+  IIRApproximation getApproximation() const;
+  FilterPass getPassType() const;
+  int getOrder() const;
+  const std::vector<BiquadSection> &getSections() const;
+
+  std::vector<double> getFilterCoefficients() const override;
+  FrequencyResponse<>
+  calculateFrequencyResponse(const FrequencyGrid &grid) const override;
+  std::vector<double> apply(const std::vector<double> &samples) const override;
+
+  static int getOptimalOrder(IIRApproximation approximation,
+                             FilterPass passType, int cutoffFrequency,
+                             int transitionLength, double attenuationDB,
+                             int samplingRate,
+                             double passBandRippleDB = defaultPassBandRippleDB);
+
+private:
+  const IIRApproximation approximation;
+  const FilterPass passType;
+  const int order;
+  std::vector<BiquadSection> sections;
+};
+
+#endif
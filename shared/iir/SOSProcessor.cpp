@@ -0,0 +1,106 @@
+#include "SOSProcessor.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// samples passed through all sections at once, stays in L1 cache
+constexpr int blockSize = 256;
+
+} // namespace
+
+/**
+ * Streaming second order sections filter.
+ * Sections are copied once, processing doesn't allocate.
+ *
+ * @param filter IIR filter to take sections from
+ */
+SOSProcessor::SOSProcessor(const SOSFilter &filter)
+    : sections{filter.getSections()}, states(sections.size()) {}
+
+int SOSProcessor::getSectionsCount() const { return sections.size(); }
+
+/**
+ * Set filter state to the steady state of a constant input
+ *
+ * @param input constant input the filter has settled on, 0 to clear
+ */
+void SOSProcessor::reset(double input) {
+  for (unsigned int i = 0; i < sections.size(); i++) {
+    const auto &section = sections[i];
+    const double output = input * (section.b0 + section.b1 + section.b2) /
+                          (1 + section.a1 + section.a2);
+    states[i].s2 = section.b2 * input - section.a2 * output;
+    states[i].s1 = section.b1 * input - section.a1 * output + states[i].s2;
+    input = output;
+  }
+}
+
+/**
+ * Filter next block of samples.
+ * For every section:
+ * Vout[n] = b0 * Vin[n] + s1
+ * s1 = b1 * Vin[n] - a1 * Vout[n] + s2
+ * s2 = b2 * Vin[n] - a2 * Vout[n]
+ *
+ * Samples are filtered in short blocks passed through one section after
+ * another, so that the section coefficients and state stay in registers
+ * and the block stays in cache.
+ *
+ * @param input count input samples
+ * @param output buffer for count filtered samples, may be the same as input
+ * @param count number of samples
+ */
+void SOSProcessor::process(const double *input, double *output, int count) {
+  if (sections.empty()) {
+    copy(input, input + count, output);
+    return;
+  }
+
+  for (int from = 0; from < count; from += blockSize) {
+    const int size = min(blockSize, count - from);
+    const double *blockInput = input + from;
+    double *blockOutput = output + from;
+
+    for (unsigned int i = 0; i < sections.size(); i++) {
+      const auto [b0, b1, b2, a1, a2] = sections[i];
+      double s1 = states[i].s1;
+      double s2 = states[i].s2;
+      // first section reads the input, others filter the output in-place
+      const double *sectionInput = i == 0 ? blockInput : blockOutput;
+      for (int n = 0; n < size; n++) {
+        const double x = sectionInput[n];
+        const double y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        blockOutput[n] = y;
+      }
+      states[i].s1 = s1;
+      states[i].s2 = s2;
+    }
+  }
+}
+
+/**
+ * Filter next block of samples in-place
+ *
+ * @param samples count samples to replace with filtered ones
+ * @param count number of samples
+ */
+void SOSProcessor::process(double *samples, int count) {
+  process(samples, samples, count);
+}
+
+/**
+ * Filter next block of samples
+ *
+ * @param input input samples
+ * @return filtered samples
+ */
+vector<double> SOSProcessor::process(const vector<double> &input) {
+  vector<double> output(input.size());
+  process(input.data(), output.data(), input.size());
+
+  return output;
+}
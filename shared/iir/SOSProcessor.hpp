@@ -0,0 +1,33 @@
+#ifndef SOS_PROCESSOR_H
+#define SOS_PROCESSOR_H
+
+#include "SOSFilter.hpp"
+#include <vector>
+
+/**
+ * Streaming cascade of second order sections in transposed direct form II.
+ * Keeps two state variables per section between process() calls, so that a
+ * continuous stream can be filtered in arbitrary sized blocks.
+ */
+class SOSProcessor {
+public:
+  explicit SOSProcessor(const SOSFilter &filter);
+
+  int getSectionsCount() const;
+
+  void process(const double *input, double *output, int count);
+  void process(double *samples, int count);
+  std::vector<double> process(const std::vector<double> &input);
+  void reset(double input = 0);
+
+private:
+  struct State {
+    double s1 = 0;
+    double s2 = 0;
+  };
+
+  std::vector<BiquadSection> sections;
+  std::vector<State> states;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "../shared/Decimation.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(Decimation_test)
+
+BOOST_AUTO_TEST_CASE(small_range_test) {
+  vector<double> x = {1, 2, 3, 4, 5};
+  vector<double> y = {0, -1, 3, 2, 1};
+
+  auto indices = decimateMinMax(x, y, 1, 4, 10);
+  BOOST_TEST(indices == vector<int>({1, 2, 3}));
+
+  BOOST_CHECK_THROW(decimateMinMax(x, vector<double>{1}, 0, 5, 10), invalid_argument);
+  BOOST_CHECK_THROW(decimateMinMax(x, y, 0, 5, 0), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(peaks_preserved_test) {
+  const int pointsCount = 100000;
+  const int bucketsCount = 800;
+
+  vector<double> x, y;
+  for (int i = 0; i < pointsCount; i++) {
+    x.push_back(i + 1);
+    y.push_back(-60 + 10 * sin(i * 0.37));
+  }
+  // narrow notch and peak, single point wide
+  y[12345] = -200;
+  y[67890] = 5;
+
+  auto indices = decimateMinMax(x, y, 0, pointsCount, bucketsCount);
+  BOOST_TEST(indices.size() <= static_cast<size_t>(2 * bucketsCount));
+  BOOST_TEST(indices.size() > static_cast<size_t>(bucketsCount));
+
+  for (unsigned int i = 1; i < indices.size(); i++) {
+    BOOST_TEST(indices[i] > indices[i - 1]);
+  }
+  BOOST_TEST(count(indices.begin(), indices.end(), 12345) == 1);
+  BOOST_TEST(count(indices.begin(), indices.end(), 67890) == 1);
+
+  double minY = INFINITY, maxY = -INFINITY;
+  for (int i : indices) {
+    minY = min(minY, y[i]);
+    maxY = max(maxY, y[i]);
+  }
+  BOOST_TEST(minY == -200);
+  BOOST_TEST(maxY == 5);
+}
+
+BOOST_AUTO_TEST_CASE(uneven_x_test) {
+  // coarse-to-fine responses have uneven frequencies
+  vector<double> x, y;
+  for (int i = 0; i < 1000; i++) {
+    x.push_back(i < 500 ? i * 10 : 5000 + (i - 500) * 0.1);
+    y.push_back(i == 750 ? -1000 : -(i % 7));
+  }
+
+  auto indices = decimateMinMax(x, y, 0, x.size(), 100);
+  BOOST_TEST(indices.size() <= 200u);
+  BOOST_TEST(count(indices.begin(), indices.end(), 750) == 1);
+  BOOST_TEST(indices.front() <= 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
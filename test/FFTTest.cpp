@@ -3,6 +3,10 @@
 #include "Welle.hpp"
 #include <boost/test/unit_test.hpp>
 #include <complex>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
 
 using namespace std;
 
@@ -34,4 +38,172 @@ BOOST_AUTO_TEST_CASE(direct_inverse_test) {
   }
 }
 
+void realTransformTest(int size) {
+  vector<double> samples;
+  for (int i = 0; i < size; i++) {
+    samples.push_back(sin(i * 0.37) + (i % 5) * 0.1);
+  }
+
+  auto complexResult = fft::direct(fft::toComplexVector(samples));
+  auto halfSpectrum = fft::directReal(samples);
+  BOOST_TEST(halfSpectrum.size() == size / 2 + 1);
+
+  // half spectrum expanded using Hermitian symmetry must match complex DFT
+  auto fullSpectrum = fft::toFullSpectrum(halfSpectrum, size);
+  BOOST_TEST(fullSpectrum.size() == size);
+
+  const double tolerance = 1e-8;
+  for (int i = 0; i < size; i++) {
+    BOOST_TEST(abs(fullSpectrum[i] - complexResult[i]) < tolerance);
+  }
+
+  // inverse transform is not normalized
+  auto restored = fft::inverseReal(halfSpectrum, size);
+  BOOST_TEST(restored.size() == size);
+  for (int i = 0; i < size; i++) {
+    BOOST_TEST(abs(restored[i] / size - samples[i]) < tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(real_transform_test) {
+  realTransformTest(1);
+  realTransformTest(2);
+  realTransformTest(15);
+  realTransformTest(64);
+  realTransformTest(1001);
+
+  BOOST_REQUIRE_THROW(fft::inverseReal(vector<complex<double>>(3), 10),
+                      invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(plan_cache_test) {
+  fft::clearPlanCache();
+  BOOST_TEST(fft::planCacheSize() == 0);
+
+  vector<complex<double>> samples;
+  for (int i = 0; i < 64; i++) {
+    samples.push_back(complex<double>(i % 7, i % 3));
+  }
+
+  auto first = fft::direct(samples);
+  auto second = fft::direct(samples);
+  BOOST_TEST(fft::planCacheSize() == 1);
+  BOOST_TEST(first == second);
+
+  fft::inverse(samples);
+  BOOST_TEST(fft::planCacheSize() == 2);
+
+  // in-place transform must give the same result as out-of-place one
+  auto inPlace = samples;
+  fft::transformInPlace(inPlace);
+  BOOST_TEST(fft::planCacheSize() == 3);
+
+  const double tolerance = 1e-8;
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    BOOST_TEST(abs(inPlace[i] - first[i]) < tolerance);
+  }
+
+  fft::clearPlanCache();
+  BOOST_TEST(fft::planCacheSize() == 0);
+
+  // least recently used plans are dropped
+  for (int size = 1; size <= 100; size++) {
+    fft::directReal(vector<double>(size, 1));
+  }
+  BOOST_TEST(fft::planCacheSize() < 100);
+  BOOST_TEST(fft::directReal(vector<double>(3, 1))[0] == complex<double>(3));
+
+  fft::clearPlanCache();
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_transform_test) {
+  const vector<int> sizes = {64, 100, 1024, 4097};
+  vector<vector<double>> inputs;
+  vector<vector<complex<double>>> expected;
+  for (int size : sizes) {
+    vector<double> samples;
+    for (int i = 0; i < size; i++) {
+      samples.push_back(sin(i * 0.1) + (i % 5));
+    }
+    inputs.push_back(samples);
+    expected.push_back(fft::directReal(samples));
+  }
+
+  // threads share cached plans, each transforms on its own buffers
+  vector<int> mismatches(8, 0);
+  vector<thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&, t]() {
+      for (int repeat = 0; repeat < 50; repeat++) {
+        const int index = (t + repeat) % sizes.size();
+        if (fft::directReal(inputs[index]) != expected[index]) {
+          mismatches[t]++;
+        }
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (int count : mismatches) {
+    BOOST_TEST(count == 0);
+  }
+}
+
+/**
+ * @return FFTW wisdom accumulated so far
+ */
+string exportWisdomString() {
+  char *wisdom = fftw_export_wisdom_to_string();
+  const string result = wisdom ? wisdom : "";
+  fftw_free(wisdom);
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(planning_mode_test) {
+  vector<complex<double>> samples;
+  for (int i = 0; i < 128; i++) {
+    samples.push_back(complex<double>(i % 5));
+  }
+  auto estimated = fft::direct(samples);
+
+  fft::setPlanningMode(fft::PlanningMode::measure);
+  BOOST_TEST((fft::getPlanningMode() == fft::PlanningMode::measure));
+  // changing planning mode drops previously cached plans
+  BOOST_TEST(fft::planCacheSize() == 0);
+  auto measured = fft::direct(samples);
+
+  const double tolerance = 1e-8;
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    BOOST_TEST(abs(estimated[i] - measured[i]) < tolerance);
+  }
+
+  // sizes other than powers of two are estimated: no new wisdom is measured
+  vector<double> samplingRateSamples(48000);
+  for (int i = 0; i < 48000; i++) {
+    samplingRateSamples[i] = sin(i * 0.01);
+  }
+  const string wisdomBefore = exportWisdomString();
+  auto spectrum = fft::directReal(samplingRateSamples);
+  BOOST_TEST(spectrum.size() == 24001);
+  BOOST_TEST(exportWisdomString() == wisdomBefore);
+
+  // while powers of two are measured
+  fft::directReal(vector<double>(8192, 1));
+  BOOST_TEST(exportWisdomString() != wisdomBefore);
+
+  // concurrent test runs don't share the file
+  const auto wisdomPath =
+      filesystem::temp_directory_path() /
+      ("filter_designer_test_" + to_string(random_device{}()) + ".wisdom");
+  BOOST_TEST(fft::exportWisdom(wisdomPath.string()));
+  BOOST_TEST(fft::importWisdom(wisdomPath.string()));
+  filesystem::remove(wisdomPath);
+
+  BOOST_TEST(!fft::importWisdom("/non/existing/path.wisdom"));
+
+  fft::setPlanningMode(fft::PlanningMode::estimate);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+#include "../shared/FrequencyGrid.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(FrequencyGrid_test)
+
+BOOST_AUTO_TEST_CASE(linear_test) {
+  auto grid = FrequencyGrid::linear(100, 200, 11);
+
+  BOOST_TEST(grid.size() == 11);
+  BOOST_TEST(grid.isUniform());
+  BOOST_TEST(grid.getStep() == 10);
+  BOOST_TEST(grid.getFrequencies().front() == 100);
+  BOOST_TEST(grid.getFrequencies().back() == 200);
+
+  auto single = FrequencyGrid::linear(50, 50, 1);
+  BOOST_TEST(single.size() == 1);
+  BOOST_TEST(!single.isUniform());
+
+  BOOST_REQUIRE_THROW(FrequencyGrid::linear(100, 200, 0), invalid_argument);
+  BOOST_REQUIRE_THROW(FrequencyGrid::linear(200, 100, 10), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(logarithmic_test) {
+  auto grid = FrequencyGrid::logarithmic(0.1, 1000, 5);
+  const double tolerance = 1e-9;
+
+  BOOST_TEST(grid.size() == 5);
+  BOOST_TEST(!grid.isUniform());
+  auto frequencies = grid.getFrequencies();
+  BOOST_TEST(abs(frequencies[0] - 0.1) < tolerance);
+  BOOST_TEST(abs(frequencies[1] - 1) < tolerance);
+  BOOST_TEST(abs(frequencies[2] - 10) < tolerance);
+  BOOST_TEST(abs(frequencies[3] - 100) < tolerance);
+  BOOST_TEST(frequencies[4] == 1000);
+
+  BOOST_REQUIRE_THROW(FrequencyGrid::logarithmic(0, 1000, 5), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(list_test) {
+  auto grid = FrequencyGrid::list({5, 1, 100.5});
+
+  BOOST_TEST(grid.size() == 3);
+  BOOST_TEST(!grid.isUniform());
+  BOOST_TEST(grid.getFrequencies()[2] == 100.5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+#include "../shared/FrequencyResponse.hpp"
+#include "../shared/fir/BlackmanWindow.hpp"
+#include "../shared/fir/FIRFilter.hpp"
+#include "../shared/iir/LowPassRCCircuit.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(FrequencyResponse_test)
+
+BOOST_AUTO_TEST_CASE(arrays_test) {
+  FrequencyResponse<> response({1, 2, 3}, {0, -3, -6}, {0, -1, -2});
+  BOOST_TEST(response.size() == 3);
+  BOOST_TEST(!response.empty());
+  BOOST_TEST(response.getFrequencies()[2] == 3);
+  BOOST_TEST(response.getMagnitudesDB()[1] == -3);
+  BOOST_TEST(response[2].phaseShift == -2);
+
+  response.getMagnitudesDB()[0] = -1;
+  BOOST_TEST(response.toFilterResponses()[0].magnitudeDB == -1);
+
+  BOOST_CHECK_THROW(FrequencyResponse<>({1, 2}, {0}, {0, 0}),
+                    invalid_argument);
+
+  // vectors of responses are assignable
+  vector<FilterResponse> responses = response.toFilterResponses();
+  responses = FrequencyResponse<>().toFilterResponses();
+  BOOST_TEST(responses.empty());
+}
+
+BOOST_AUTO_TEST_CASE(float_storage_test) {
+  BlackmanWindow window;
+  FIRFilter filter(FilterPass::lowPass, 1000, 101, window, 44100);
+  const auto grid = FrequencyGrid::linear(1, 22049, 22049);
+
+  const auto response = filter.calculateFrequencyResponse(grid);
+  const FrequencyResponse<float> floatResponse(response);
+  BOOST_TEST(floatResponse.size() == response.size());
+  BOOST_TEST(sizeof(floatResponse.getMagnitudesDB()[0]) == sizeof(float));
+
+  for (int i = 0; i < response.size(); i++) {
+    const double magnitude = response.getMagnitudesDB()[i];
+    if (isfinite(magnitude)) {
+      BOOST_TEST(abs(floatResponse.getMagnitudesDB()[i] - magnitude) <
+                 1e-3);
+    }
+    BOOST_TEST(abs(floatResponse.getPhaseShifts()[i] -
+                   response.getPhaseShifts()[i]) < 1e-6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(same_as_filter_response_test) {
+  LowPassRCCircuit circuit(500, 48000);
+  const auto grid = FrequencyGrid::logarithmic(10, 20000, 100);
+
+  const auto expected = circuit.calculateResponse(grid);
+  const auto response = circuit.calculateFrequencyResponse(grid);
+  BOOST_TEST(response.size() == static_cast<int>(expected.size()));
+  for (int i = 0; i < response.size(); i++) {
+    BOOST_TEST(response.getFrequencies()[i] == grid.getFrequencies()[i]);
+    BOOST_TEST(response.getMagnitudesDB()[i] == expected[i].magnitudeDB);
+    BOOST_TEST(response.getPhaseShifts()[i] == expected[i].phaseShift);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(unwrap_test) {
+  FrequencyResponse<float> response(
+      {1, 2, 3, 4}, {0, 0, 0, 0},
+      {0, -numbers::pi_v<float> * 0.9f, numbers::pi_v<float> * 0.9f, 0});
+  response.unwrapPhaseShifts();
+  const auto phases = response.getPhaseShifts();
+  BOOST_TEST(abs(phases[2] + 1.1 * numbers::pi) < 1e-5);
+  BOOST_TEST(abs(phases[3] + 2 * numbers::pi) < 1e-5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,60 @@
+#include "../shared/LRUCache.hpp"
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(LRUCache_test)
+
+BOOST_AUTO_TEST_CASE(entries_limit_test) {
+  LRUCache<int, string> cache(2, 100);
+
+  cache.put(1, "one");
+  cache.put(2, "two");
+  BOOST_TEST(*cache.get(1) == "one");
+
+  // 2 is the least recently used one
+  cache.put(3, "three");
+  BOOST_TEST(cache.size() == 2);
+  BOOST_TEST(cache.contains(1));
+  BOOST_TEST(!cache.contains(2));
+  BOOST_TEST(cache.get(2) == nullptr);
+  BOOST_TEST(*cache.get(3) == "three");
+
+  BOOST_TEST(cache.getHitsCount() == 2);
+  BOOST_TEST(cache.getMissesCount() == 1);
+
+  BOOST_CHECK_THROW((LRUCache<int, int>(0, 100)), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(cost_limit_test) {
+  LRUCache<string, int> cache(10, 100);
+
+  cache.put("a", 1, 40);
+  cache.put("b", 2, 40);
+  BOOST_TEST(cache.getCost() == 80u);
+
+  cache.put("c", 3, 40);
+  BOOST_TEST(!cache.contains("a"));
+  BOOST_TEST(cache.getCost() == 80u);
+
+  // replacing a value replaces its cost
+  cache.put("b", 4, 10);
+  BOOST_TEST(*cache.get("b") == 4);
+  BOOST_TEST(cache.getCost() == 50u);
+
+  // too expensive values are not cached
+  cache.put("d", 5, 101);
+  BOOST_TEST(!cache.contains("d"));
+  BOOST_TEST(cache.size() == 2);
+
+  cache.setLimits(10, 20);
+  BOOST_TEST(cache.size() == 1);
+  BOOST_TEST(cache.contains("b"));
+
+  cache.remove("b");
+  BOOST_TEST(cache.size() == 0);
+  BOOST_TEST(cache.getCost() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,88 @@
+#include "../shared/ProgressiveResponse.hpp"
+#include "../shared/fir/BlackmanWindow.hpp"
+#include "../shared/fir/FIRFilter.hpp"
+#include "../shared/iir/LowPassRCCircuit.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(ProgressiveResponse_test)
+
+BOOST_AUTO_TEST_CASE(complete_response_test) {
+  const int samplingRate = 8000;
+  FIRFilter fir(FilterPass::lowPass, 1000, 101, BlackmanWindow(),
+                samplingRate);
+  LowPassRCCircuit iir(1000, samplingRate);
+
+  for (const Filter *filter : {static_cast<const Filter *>(&fir),
+                               static_cast<const Filter *>(&iir)}) {
+    ProgressiveResponse progressive(*filter, 1, 3999, 1, 64);
+    BOOST_TEST(progressive.size() == 64);
+    BOOST_TEST(!progressive.isComplete());
+
+    int added = 0;
+    while ((added = progressive.refine(progressive.size())) > 0) {
+    }
+    BOOST_TEST(progressive.isComplete());
+    BOOST_TEST(progressive.size() == 3999);
+    BOOST_TEST(progressive.refine(100) == 0);
+
+    const auto frequencies = progressive.getFrequencies();
+    const auto expected =
+        filter->calculateResponse(FrequencyGrid::linear(1, 3999, 3999));
+    const auto magnitudes = progressive.getMagnitudesDB();
+    const auto phases = progressive.getPhaseShifts();
+
+    const double tolerance = 1e-4;
+    for (unsigned int i = 0; i < expected.size(); i++) {
+      BOOST_TEST(frequencies[i] == i + 1.0);
+      if (isfinite(expected[i].magnitudeDB) && expected[i].magnitudeDB > -200) {
+        BOOST_TEST(abs(magnitudes[i] - expected[i].magnitudeDB) < tolerance);
+        BOOST_TEST(abs(remainder(phases[i] - expected[i].phaseShift,
+                                 2 * M_PI)) < tolerance);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(adaptive_refinement_test) {
+  const int samplingRate = 48000;
+  const int cutoffFrequency = 2000;
+  FIRFilter filter(FilterPass::lowPass, cutoffFrequency, 301,
+                   BlackmanWindow(), samplingRate);
+
+  ProgressiveResponse progressive(filter, 1, 23999, 1, 128);
+  const auto coarse = progressive.getFrequencies();
+  BOOST_TEST(progressive.refine(32) == 32);
+  const auto refined = progressive.getFrequencies();
+  BOOST_TEST(refined.size() == coarse.size() + 32);
+
+  // flat pass band gets fewer new points than the transition band
+  auto countBetween = [](const vector<double> &frequencies, double from,
+                         double to) {
+    return count_if(frequencies.begin(), frequencies.end(),
+                    [&](double f) { return f >= from && f < to; });
+  };
+  const double band = 1000;
+  const int passBandAdded = countBetween(refined, 1, band) -
+                            countBetween(coarse, 1, band);
+  const int transitionBandAdded =
+      countBetween(refined, cutoffFrequency, cutoffFrequency + band) -
+      countBetween(coarse, cutoffFrequency, cutoffFrequency + band);
+  BOOST_TEST(transitionBandAdded > passBandAdded);
+
+  for (unsigned int i = 1; i < refined.size(); i++) {
+    BOOST_TEST(refined[i] > refined[i - 1]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_arguments_test) {
+  LowPassRCCircuit filter(1000, 48000);
+  BOOST_CHECK_THROW(ProgressiveResponse(filter, 100, 10), invalid_argument);
+  BOOST_CHECK_THROW(ProgressiveResponse(filter, 1, 100, 0), invalid_argument);
+  BOOST_CHECK_THROW(ProgressiveResponse(filter, 1, 100, 1, 1),
+                    invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,58 @@
+#include "../shared/RangeMinMax.hpp"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(RangeMinMax_test)
+
+BOOST_AUTO_TEST_CASE(empty_test) {
+  RangeMinMax range;
+  BOOST_TEST(range.size() == 0);
+  BOOST_TEST(range.getMin(0, 0) == INFINITY);
+  BOOST_TEST(range.getMax(0, 0) == -INFINITY);
+  BOOST_CHECK_THROW(range.getMin(0, 1), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(non_finite_test) {
+  const vector<double> values = {-INFINITY, 3, NAN, -2, INFINITY};
+  RangeMinMax range(values);
+  BOOST_TEST(range.size() == 5);
+  BOOST_TEST(range.getMin(0, 5) == -2);
+  BOOST_TEST(range.getMax(0, 5) == 3);
+  BOOST_TEST(range.getMin(0, 1) == INFINITY);
+  BOOST_TEST(range.getMax(4, 5) == -INFINITY);
+  BOOST_CHECK_THROW(range.getMax(-1, 2), invalid_argument);
+  BOOST_CHECK_THROW(range.getMax(0, 6), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(brute_force_test) {
+  mt19937 generator(42);
+  uniform_real_distribution<double> distribution(-100, 100);
+
+  vector<double> values(1000);
+  for (auto &value : values) {
+    value = distribution(generator);
+  }
+  RangeMinMax range(values);
+
+  uniform_int_distribution<int> index(0, values.size());
+  for (int i = 0; i < 1000; i++) {
+    int from = index(generator);
+    int to = index(generator);
+    if (from > to) {
+      swap(from, to);
+    }
+    if (from == to) {
+      continue;
+    }
+    BOOST_TEST(range.getMin(from, to) ==
+               *min_element(values.begin() + from, values.begin() + to));
+    BOOST_TEST(range.getMax(from, to) ==
+               *max_element(values.begin() + from, values.begin() + to));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
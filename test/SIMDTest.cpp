@@ -0,0 +1,97 @@
+#include "../shared/SIMD.hpp"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(SIMD_test)
+
+template <typename T> vector<T> generateValues(int count, int seed) {
+  vector<T> values;
+  for (int i = 0; i < count; i++) {
+    values.push_back(sin(0.37 * (i + 1) * seed) + 0.1 * cos(1.3 * i));
+  }
+  return values;
+}
+
+template <typename T> vector<T> symmetrize(vector<T> coefficients) {
+  const int count = coefficients.size();
+  for (int i = 0; i < count / 2; i++) {
+    coefficients[count - 1 - i] = coefficients[i];
+  }
+  return coefficients;
+}
+
+template <typename T> void kernelsTest(double tolerance) {
+  const auto instructionSets = simd::getSupportedInstructionSets();
+  BOOST_TEST((instructionSets.front() == simd::InstructionSet::scalar));
+  const auto defaultInstructionSet = simd::getInstructionSet();
+  BOOST_TEST((defaultInstructionSet == instructionSets.back()));
+
+  // cover vector bodies and scalar tails of all the register widths
+  for (int count : {1, 2, 3, 7, 8, 15, 16, 17, 31, 33, 64, 101, 255}) {
+    const auto a = generateValues<T>(count, 1);
+    const auto b = generateValues<T>(count, 2);
+    const auto symmetric = symmetrize(a);
+
+    simd::setInstructionSet(simd::InstructionSet::scalar);
+    const T expectedDot = simd::dotProduct(a.data(), b.data(), count);
+    const T expectedSymmetric =
+        simd::dotProduct(symmetric.data(), b.data(), count);
+
+    for (int channels : {1, 3, 4, 8, 19}) {
+      const auto frames = generateValues<T>(count * channels, 3);
+
+      vector<T> expectedChannels(channels);
+      simd::interleavedDotProduct(a.data(), count, frames.data(), channels,
+                                  expectedChannels.data());
+
+      for (auto instructionSet : instructionSets) {
+        simd::setInstructionSet(instructionSet);
+        vector<T> actualChannels(channels);
+        simd::interleavedDotProduct(a.data(), count, frames.data(), channels,
+                                    actualChannels.data());
+        for (int ch = 0; ch < channels; ch++) {
+          BOOST_TEST(abs(actualChannels[ch] - expectedChannels[ch]) <
+                     tolerance);
+        }
+      }
+      simd::setInstructionSet(simd::InstructionSet::scalar);
+    }
+
+    for (auto instructionSet : instructionSets) {
+      simd::setInstructionSet(instructionSet);
+      BOOST_TEST((simd::getInstructionSet() == instructionSet));
+
+      BOOST_TEST(abs(simd::dotProduct(a.data(), b.data(), count) -
+                     expectedDot) < tolerance);
+      BOOST_TEST(
+          abs(simd::symmetricDotProduct(symmetric.data(), b.data(), count) -
+              expectedSymmetric) < tolerance);
+    }
+  }
+
+  simd::setInstructionSet(defaultInstructionSet);
+}
+
+BOOST_AUTO_TEST_CASE(double_kernels_test) { kernelsTest<double>(1e-10); }
+
+BOOST_AUTO_TEST_CASE(float_kernels_test) { kernelsTest<float>(1e-3); }
+
+BOOST_AUTO_TEST_CASE(unsupported_instruction_set_test) {
+  const auto instructionSets = simd::getSupportedInstructionSets();
+  for (auto instructionSet :
+       {simd::InstructionSet::avx2, simd::InstructionSet::avx512,
+        simd::InstructionSet::neon}) {
+    if (find(instructionSets.begin(), instructionSets.end(), instructionSet) ==
+        instructionSets.end()) {
+      BOOST_CHECK_THROW(simd::setInstructionSet(instructionSet),
+                        invalid_argument);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -37,6 +37,14 @@ BOOST_AUTO_TEST_CASE(normalize_test) {
   BOOST_TEST(actualNormalized == expectedNormalized);
 }
 
+BOOST_AUTO_TEST_CASE(normalize_gain_test) {
+  auto normalized = normalizeGain({1, 2, 4, 2, 1});
+  BOOST_TEST(normalized.size() == 5);
+  BOOST_TEST(abs(normalized[2] - 0.4) < 1e-15);
+  BOOST_TEST(abs(normalized[0] + normalized[1] + normalized[2] +
+                 normalized[3] + normalized[4] - 1) < 1e-15);
+}
+
 BOOST_AUTO_TEST_CASE(toDB_test) {
   BOOST_TEST(toDB(0) == -std::numeric_limits<double>::infinity());
   BOOST_TEST(toDB(0.0001) == -80);
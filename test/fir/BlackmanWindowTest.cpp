@@ -25,4 +25,32 @@ BOOST_AUTO_TEST_CASE(window_apply_test) {
   BOOST_TEST(samples <= windowedSamples);
 }
 
+BOOST_AUTO_TEST_CASE(cached_coefficients_test) {
+  const int windowSize = 255;
+
+  auto window = BlackmanWindow();
+  auto cached = window.getCachedCoefficients(windowSize);
+  BOOST_TEST(*cached == window.getCoefficients(windowSize));
+
+  // same table is shared by all windows of the same type and size
+  BOOST_TEST(BlackmanWindow().getCachedCoefficients(windowSize) == cached);
+  BOOST_TEST(window.getCachedCoefficients(windowSize + 2) != cached);
+
+  // table outlives the cache entry
+  Window::clearCache();
+  BOOST_TEST(cached->size() == windowSize);
+  BOOST_TEST(window.getCachedCoefficients(windowSize) != cached);
+}
+
+BOOST_AUTO_TEST_CASE(window_apply_in_place_test) {
+  std::vector<double> samples(31, 2);
+
+  auto window = BlackmanWindow();
+  auto expected = window.apply(samples);
+  window.applyInPlace(samples);
+
+  BOOST_TEST(samples == expected);
+  BOOST_TEST(samples[15] == 2 * window.getCoefficients(31)[15]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+#include "../../shared/fir/DecimationPlan.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(DecimationPlan_test)
+
+BOOST_AUTO_TEST_CASE(stages_test) {
+  DecimationPlan plan(192000, {8, 6, 4}, 400, 80);
+  BOOST_TEST(plan.getOutputSamplingRate() == 1000);
+  BOOST_TEST(plan.getFactor() == 192);
+  BOOST_TEST_REQUIRE(plan.getStages().size() == 3);
+
+  const KaiserWindow window(80);
+  double macsPerSecond = 0;
+  double latency = 0;
+  int samplingRate = 192000;
+  for (const auto &stage : plan.getStages()) {
+    const int outputSamplingRate = samplingRate / stage.factor;
+    BOOST_TEST(stage.inputSamplingRate == samplingRate);
+    // nothing aliases into the final band, pass band is kept
+    BOOST_TEST(stage.cutoffFrequency + stage.transitionLength <=
+               outputSamplingRate - 500);
+    BOOST_TEST(stage.cutoffFrequency - stage.transitionLength >= 400);
+    BOOST_TEST(stage.coefficientsCount ==
+               FIRFilter::getOptimalCoefficientsCount(samplingRate, window,
+                                                      stage.transitionLength));
+    macsPerSecond += stage.macsPerSecond;
+    latency += stage.latency;
+    samplingRate = outputSamplingRate;
+  }
+  BOOST_TEST(plan.getMACsPerSecond() == macsPerSecond);
+  BOOST_TEST(plan.getLatency() == latency);
+
+  // the last stage has the narrow transition band
+  BOOST_TEST(plan.getStages().back().cutoffFrequency +
+                 plan.getStages().back().transitionLength ==
+             500);
+}
+
+BOOST_AUTO_TEST_CASE(optimal_plan_test) {
+  const auto plan = DecimationPlan::createOptimal(192000, 1000, 400, 80);
+  BOOST_TEST(plan.getFactor() == 192);
+  BOOST_TEST(plan.getStages().size() > 1);
+  BOOST_TEST(plan.getStages().size() <= DecimationPlan::defaultMaxStagesCount);
+
+  // a cascade is many times cheaper than a single filter
+  DecimationPlan singleStage(192000, {192}, 400, 80);
+  BOOST_TEST(plan.getMACsPerSecond() * 4 < singleStage.getMACsPerSecond());
+
+  // no other factorization is cheaper
+  for (const auto &factors :
+       {vector<int>{2, 96}, vector<int>{16, 12}, vector<int>{12, 16},
+        vector<int>{8, 6, 4}, vector<int>{4, 6, 8}, vector<int>{2, 2, 48},
+        vector<int>{4, 4, 3, 4}, vector<int>{2, 2, 2, 24}}) {
+    DecimationPlan other(192000, factors, 400, 80);
+    BOOST_TEST(plan.getMACsPerSecond() <= other.getMACsPerSecond());
+  }
+
+  const auto singleStagePlan =
+      DecimationPlan::createOptimal(192000, 1000, 400, 80, 1);
+  BOOST_TEST(singleStagePlan.getStages().size() == 1);
+  BOOST_TEST(singleStagePlan.getMACsPerSecond() ==
+             singleStage.getMACsPerSecond());
+
+  // prime factor can't be split
+  const auto primePlan =
+      DecimationPlan::createOptimal(48000 * 7, 48000, 20000, 60);
+  BOOST_TEST(primePlan.getStages().size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_parameters_test) {
+  BOOST_REQUIRE_THROW(DecimationPlan(48000, {}, 1000, 60), invalid_argument);
+  BOOST_REQUIRE_THROW(DecimationPlan(48000, {0}, 1000, 60), invalid_argument);
+  BOOST_REQUIRE_THROW(DecimationPlan(48000, {7}, 1000, 60), invalid_argument);
+  BOOST_REQUIRE_THROW(DecimationPlan(48000, {2}, 0, 60), invalid_argument);
+  // pass band beyond the output Nyquist frequency
+  BOOST_REQUIRE_THROW(DecimationPlan(48000, {2, 3}, 4000, 60),
+                      invalid_argument);
+
+  BOOST_REQUIRE_THROW(DecimationPlan::createOptimal(48000, 44100, 1000, 60),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(DecimationPlan::createOptimal(1000, 2000, 100, 60),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(DecimationPlan::createOptimal(48000, 1000, 100, 60, 0),
+                      invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
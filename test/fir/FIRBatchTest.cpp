@@ -0,0 +1,109 @@
+#include "../../shared/fir/FIRBatch.hpp"
+#include "../../shared/fir/BlackmanWindow.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/RectangularWindow.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(FIRBatch_test)
+
+BOOST_AUTO_TEST_CASE(parameter_sweep_test) {
+  const BlackmanWindow blackman;
+  const RectangularWindow rectangular;
+  const int samplingRate = 48000;
+
+  vector<FIRDesignParameters> designs;
+  for (auto passType : {FilterPass::lowPass, FilterPass::highPass}) {
+    for (int cutoffFrequency = 500; cutoffFrequency < 20000;
+         cutoffFrequency += 2500) {
+      for (int coefficientsCount : {31, 100, 257}) {
+        for (const Window *window :
+             {static_cast<const Window *>(&blackman),
+              static_cast<const Window *>(&rectangular)}) {
+          designs.push_back({passType, cutoffFrequency, coefficientsCount,
+                             window, samplingRate});
+        }
+      }
+    }
+  }
+  const auto grid = FrequencyGrid::logarithmic(10, 23000, 200);
+
+  for (int threadsCount : {1, 4, 0}) {
+    const auto result = designFIRBatch(designs, grid, threadsCount);
+    BOOST_TEST(result.size() == static_cast<int>(designs.size()));
+    BOOST_TEST(result.responseSize == grid.size());
+
+    for (unsigned int i = 0; i < designs.size(); i++) {
+      const auto &design = designs[i];
+      const FIRFilter filter(design.passType, design.cutoffFrequency,
+                             design.coefficientsCount, *design.window,
+                             design.samplingRate);
+
+      const auto expectedCoefficients = filter.getFilterCoefficients();
+      const auto coefficients = result.getCoefficients(i);
+      BOOST_TEST(coefficients.size() == expectedCoefficients.size());
+      for (unsigned int j = 0; j < coefficients.size(); j++) {
+        BOOST_TEST(coefficients[j] == expectedCoefficients[j]);
+      }
+
+      const auto expectedResponse = filter.calculateResponse(grid);
+      const auto magnitudes = result.getMagnitudesDB(i);
+      const auto phases = result.getPhaseShifts(i);
+      for (int j = 0; j < grid.size(); j++) {
+        BOOST_TEST(magnitudes[j] == expectedResponse[j].magnitudeDB);
+        BOOST_TEST(phases[j] == expectedResponse[j].phaseShift);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(persistent_pool_test) {
+  const BlackmanWindow window;
+  const auto grid = FrequencyGrid::linear(0, 24000, 241);
+  vector<FIRDesignParameters> designs;
+  for (int coefficientsCount = 11; coefficientsCount < 400;
+       coefficientsCount += 13) {
+    designs.push_back(
+        {FilterPass::lowPass, 3000, coefficientsCount, &window, 48000});
+  }
+
+  FIRBatchDesigner designer(3);
+  BOOST_TEST(designer.getThreadsCount() == 3);
+
+  // the same threads design every batch, one or several of them
+  const auto expected = designer.design(designs, grid, 1);
+  for (int repeat = 0; repeat < 10; repeat++) {
+    const auto result = designer.design(designs, grid, repeat % 4);
+    BOOST_TEST(result.coefficients == expected.coefficients);
+    BOOST_TEST(result.magnitudesDB == expected.magnitudesDB);
+    BOOST_TEST(result.phaseShifts == expected.phaseShifts);
+  }
+
+  // pool stays usable after a failed batch
+  designs[5].cutoffFrequency = 30000;
+  BOOST_CHECK_THROW(designer.design(designs, grid), invalid_argument);
+  designs[5].cutoffFrequency = 3000;
+  BOOST_TEST(designer.design(designs, grid).coefficients ==
+             expected.coefficients);
+
+  BOOST_CHECK_THROW(FIRBatchDesigner(-1), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_design_test) {
+  const BlackmanWindow window;
+  const auto grid = FrequencyGrid::linear(0, 1000, 11);
+
+  vector<FIRDesignParameters> designs(
+      20, {FilterPass::lowPass, 1000, 51, &window, 48000});
+  // cutoff above Nyquist frequency
+  designs[13].cutoffFrequency = 30000;
+  BOOST_CHECK_THROW(designFIRBatch(designs, grid, 3), invalid_argument);
+
+  designs[13].window = nullptr;
+  BOOST_CHECK_THROW(designFIRBatch(designs, grid), invalid_argument);
+
+  BOOST_TEST(designFIRBatch({}, grid).size() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
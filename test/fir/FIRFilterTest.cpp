@@ -1,7 +1,13 @@
 #include "../../shared/fir/FIRFilter.hpp"
 #include "../../shared/fir/BlackmanWindow.hpp"
+#include "../../shared/fir/HannWindow.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include "../../shared/fir/RectangularWindow.hpp"
+#include "../../shared/FFT.hpp"
+#include "../../shared/Sampling.hpp"
 #include <boost/test/unit_test.hpp>
 #include <cmath>
+#include <numbers>
 
 using namespace std;
 
@@ -55,6 +61,89 @@ BOOST_AUTO_TEST_CASE(ideal_frequency_response_test) {
   idealFrequencyResponseTest(FilterPass::highPass, 7000, 15000, 440);
 }
 
+void idealImpulseResponseTest(FilterPass pass, int cutoffFrequency,
+                              int samplingRate, int filterSize) {
+  FIRFilter filter = FIRFilter(pass, cutoffFrequency, filterSize,
+                               BlackmanWindow(), samplingRate);
+  const int modellingLowPassFrequency =
+      pass == FilterPass::lowPass ? cutoffFrequency
+                                  : samplingRate / 2 - cutoffFrequency;
+
+  // closed form impulse response must match inverse DFT of the ideal
+  // frequency response
+  auto idealFrequencyResponse = filter.generateIdealFrequencyResponse();
+  auto timeDomain =
+      fft::inverse(fft::toComplexVector(idealFrequencyResponse));
+  auto impulseResponse = FIRFilter::calculateIdealImpulseResponse(
+      modellingLowPassFrequency, samplingRate, filterSize);
+
+  BOOST_TEST(impulseResponse.size() == filterSize);
+
+  const double tolerance = 1e-6 * samplingRate;
+  for (int i = 0; i < filterSize; i++) {
+    const int n = abs(filterSize / 2 - i);
+    BOOST_TEST(abs(impulseResponse[i] - timeDomain[n].real()) < tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ideal_impulse_response_test) {
+  idealImpulseResponseTest(FilterPass::lowPass, 20, 100, 20);
+  idealImpulseResponseTest(FilterPass::lowPass, 1500, 21000, 373);
+  idealImpulseResponseTest(FilterPass::lowPass, 2000, 48000, 500);
+  idealImpulseResponseTest(FilterPass::highPass, 10000, 48000, 501);
+  idealImpulseResponseTest(FilterPass::highPass, 7000, 15000, 440);
+
+  // fractional cutoff falls in between the integer ones
+  auto lower = FIRFilter::calculateIdealImpulseResponse(100, 48000, 51);
+  auto fractional = FIRFilter::calculateIdealImpulseResponse(100.5, 48000, 51);
+  auto upper = FIRFilter::calculateIdealImpulseResponse(101, 48000, 51);
+  for (unsigned int i = 0; i < fractional.size(); i++) {
+    BOOST_TEST(fractional[i] >= min(lower[i], upper[i]));
+    BOOST_TEST(fractional[i] <= max(lower[i], upper[i]));
+  }
+
+  BOOST_REQUIRE_THROW(FIRFilter::calculateIdealImpulseResponse(100, 48000, 0),
+                      invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(size_sweep_test) {
+  // responses of different sizes are sliced from the same cached one
+  auto expected = [](double cutoffFrequency, int samplingRate, int size) {
+    vector<double> result;
+    for (int i = 0; i < size; i++) {
+      const int n = abs(size / 2 - i);
+      result.push_back(
+          n == 0 ? 2 * cutoffFrequency - 1
+                 : sin(numbers::pi * (2 * cutoffFrequency - 1) * n /
+                       samplingRate) /
+                       sin(numbers::pi * n / samplingRate));
+    }
+    return result;
+  };
+
+  for (int size : {11, 501, 2, 101, 1000, 1001, 3}) {
+    for (double cutoff : {200.0, 7000.5}) {
+      auto actual = FIRFilter::calculateIdealImpulseResponse(cutoff, 48000, size);
+      auto reference = expected(cutoff, 48000, size);
+      BOOST_TEST_REQUIRE(actual.size() == reference.size());
+      for (int i = 0; i < size; i++) {
+        BOOST_TEST(abs(actual[i] - reference[i]) < 1e-9);
+      }
+    }
+  }
+
+  // a full design sliced from the cache equals a freshly calculated one
+  BlackmanWindow window;
+  FIRFilter longer(FilterPass::highPass, 3000, 301, window, 44100);
+  FIRFilter shorter(FilterPass::highPass, 3000, 151, window, 44100);
+  auto coefficients = shorter.getFilterCoefficients();
+  BOOST_TEST(coefficients.size() == 151u);
+  BOOST_TEST(coefficients ==
+             FIRFilter(FilterPass::highPass, 3000, 151, window, 44100)
+                 .getFilterCoefficients());
+  BOOST_TEST(longer.getFilterCoefficients().size() == 301u);
+}
+
 void actualFrequencyResponseTest(FilterPass pass, int cutoffFrequency,
                                  int samplingRate, int filterSize) {
   cout << "FIR Response type=" << (pass == FilterPass::lowPass ? "low" : "high")
@@ -78,9 +167,11 @@ void actualFrequencyResponseTest(FilterPass pass, int cutoffFrequency,
   const int transitionPeriod = 500;
   const double attenuationDB = -10;
   // rought test that attenuation is -10dB at cutoff frequency + transition
-  // period
-  BOOST_TEST(filterResponse[cutoffFrequency + transitionPeriod].magnitudeDB <
-             -attenuationDB);
+  // period, if it's within the response
+  if (cutoffFrequency + transitionPeriod < samplingRate / 2) {
+    BOOST_TEST(filterResponse[cutoffFrequency + transitionPeriod].magnitudeDB <
+               -attenuationDB);
+  }
   for (const FilterResponse &f : filterResponse) {
     // test that response magnitudes are negative
     BOOST_TEST(f.magnitudeDB <= 0);
@@ -130,4 +221,113 @@ BOOST_AUTO_TEST_CASE(tansition_length_test) {
   transitionLengthTest(45, 12345, 42);
 }
 
+BOOST_AUTO_TEST_CASE(anti_aliasing_filter_test) {
+  BlackmanWindow window;
+  const auto filter =
+      FIRFilter::createAntiAliasingFilter(4, 48000, window, 1000);
+  BOOST_TEST((filter.getPassType() == FilterPass::lowPass));
+  BOOST_TEST(filter.getSamplingRate() == 48000);
+  // stop band starts at the output Nyquist frequency
+  BOOST_TEST(filter.getCutoffFrequency() == 48000 / 8 - 1000);
+  BOOST_TEST(filter.getFilterCoefficients().size() ==
+             FIRFilter::getOptimalCoefficientsCount(48000, window, 1000));
+
+  BOOST_REQUIRE_THROW(FIRFilter::createAntiAliasingFilter(0, 48000, window, 1),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(
+      FIRFilter::createAntiAliasingFilter(4, 48000, window, 6000),
+      invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(measure_attenuation_test) {
+  KaiserWindow window(60);
+  const int coefficientsCount =
+      FIRFilter::getOptimalCoefficientsCount(48000, window, 500);
+  FIRFilter filter(FilterPass::lowPass, 6000, coefficientsCount, window,
+                   48000);
+  BOOST_TEST(abs(filter.measureAttenuationDB(500) - 60) < 2);
+  // wider transition band, higher attenuation
+  BOOST_TEST(filter.measureAttenuationDB(1000) >
+             filter.measureAttenuationDB(500));
+
+  BOOST_REQUIRE_THROW(filter.measureAttenuationDB(0), invalid_argument);
+  BOOST_REQUIRE_THROW(filter.measureAttenuationDB(6001), invalid_argument);
+}
+
+void optimalCoefficientsCountTest(FilterPass passType, const Window &window,
+                                  int transitionLength) {
+  const double attenuationDB = window.getAttenuationDB();
+  const int coefficientsCount = FIRFilter::findOptimalCoefficientsCount(
+      passType, 8000, transitionLength, attenuationDB, window, 48000);
+  BOOST_TEST(coefficientsCount % 2 == 1);
+
+  // the smallest count reaching the attenuation
+  FIRFilter filter(passType, 8000, coefficientsCount, window, 48000);
+  BOOST_TEST(filter.measureAttenuationDB(transitionLength) >= attenuationDB);
+  FIRFilter shorterFilter(passType, 8000, coefficientsCount - 2, window,
+                          48000);
+  BOOST_TEST(shorterFilter.measureAttenuationDB(transitionLength) <
+             attenuationDB);
+
+  // and the shortest transition it reaches
+  const int reachedTransitionLength = FIRFilter::findTransitionLength(
+      passType, 8000, coefficientsCount, attenuationDB, window, 48000);
+  BOOST_TEST(reachedTransitionLength <= transitionLength);
+  BOOST_TEST(filter.measureAttenuationDB(reachedTransitionLength) >=
+             attenuationDB);
+  BOOST_TEST(filter.measureAttenuationDB(reachedTransitionLength - 1) <
+             attenuationDB);
+}
+
+BOOST_AUTO_TEST_CASE(find_optimal_coefficients_count_test) {
+  optimalCoefficientsCountTest(FilterPass::lowPass, HannWindow(), 100);
+  optimalCoefficientsCountTest(FilterPass::highPass, BlackmanWindow(), 300);
+  optimalCoefficientsCountTest(FilterPass::lowPass, KaiserWindow(80), 500);
+
+  // measured designs are shorter than the window estimate
+  HannWindow window;
+  BOOST_TEST(FIRFilter::findOptimalCoefficientsCount(
+                 FilterPass::lowPass, 8000, 100, window.getAttenuationDB(),
+                 window, 48000) <
+             FIRFilter::getOptimalCoefficientsCount(48000, window, 100));
+
+  // side lobes of the rectangular window don't go down with more coefficients
+  BOOST_REQUIRE_THROW(
+      FIRFilter::findOptimalCoefficientsCount(
+          FilterPass::lowPass, 8000, 100, 30, RectangularWindow(), 48000),
+      invalid_argument);
+  BOOST_REQUIRE_THROW(FIRFilter::findTransitionLength(FilterPass::lowPass,
+                                                      8000, 101, 80,
+                                                      RectangularWindow(),
+                                                      48000),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(
+      FIRFilter::findOptimalCoefficientsCount(FilterPass::lowPass, 8000, 0, 40,
+                                              window, 48000),
+      invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(find_optimal_coefficients_count_cancellation_test) {
+  HannWindow window;
+  const int estimate =
+      FIRFilter::getOptimalCoefficientsCount(48000, window, 100);
+
+  // cancelled before the first design, nothing is measured
+  BOOST_TEST(FIRFilter::findOptimalCoefficientsCount(
+                 FilterPass::lowPass, 8000, 100, window.getAttenuationDB(),
+                 window, 48000, [] { return true; }) == estimate);
+
+  // cancelled in the middle of the search, the bound found so far is kept
+  int checksCount = 0;
+  const int cancelled = FIRFilter::findOptimalCoefficientsCount(
+      FilterPass::lowPass, 8000, 100, window.getAttenuationDB(), window, 48000,
+      [&] { return ++checksCount > 3; });
+  const int found = FIRFilter::findOptimalCoefficientsCount(
+      FilterPass::lowPass, 8000, 100, window.getAttenuationDB(), window, 48000,
+      [] { return false; });
+  BOOST_TEST(checksCount == 4);
+  BOOST_TEST(cancelled >= found);
+  BOOST_TEST(cancelled <= estimate);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+#include "../../shared/fir/FIRProcessor.hpp"
+#include "../../shared/fir/BlackmanWindow.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(FIRProcessor_test)
+
+vector<double> convolve(const vector<double> &coefficients,
+                        const vector<double> &samples) {
+  vector<double> result;
+  for (int n = 0; n < static_cast<int>(samples.size()); n++) {
+    double sum = 0;
+    for (int k = 0; k < static_cast<int>(coefficients.size()) && k <= n; k++) {
+      sum += coefficients[k] * samples[n - k];
+    }
+    result.push_back(sum);
+  }
+
+  return result;
+}
+
+void streamingTest(int coefficientsCount, int partitionSize) {
+  FIRFilter filter = FIRFilter(FilterPass::lowPass, 1000, coefficientsCount,
+                               BlackmanWindow(), 48000);
+  auto coefficients = filter.getFilterCoefficients();
+
+  vector<double> samples;
+  for (int i = 0; i < 5000; i++) {
+    samples.push_back(sin(i * 0.05) + 0.3 * sin(i * 1.3) + (i % 17) * 0.01);
+  }
+  auto expected = convolve(coefficients, samples);
+
+  FIRProcessor processor(coefficients, partitionSize);
+  BOOST_TEST(processor.isPartitioned() ==
+             (coefficientsCount > FIRProcessor::maxDirectFormCoefficients));
+
+  // process the stream in blocks of varying sizes
+  vector<double> actual;
+  int blockSize = 1;
+  for (size_t i = 0; i < samples.size(); i += blockSize) {
+    blockSize = blockSize % 300 + 37;
+    vector<double> block(samples.begin() + i,
+                         samples.begin() + min(samples.size(), i + static_cast<size_t>(blockSize)));
+    auto filtered = processor.process(block);
+    actual.insert(actual.end(), filtered.begin(), filtered.end());
+  }
+
+  BOOST_TEST(actual.size() == samples.size());
+
+  const int latency = processor.getLatency();
+  const double tolerance = 1e-9;
+  for (int i = 0; i < latency; i++) {
+    BOOST_TEST(actual[i] == 0);
+  }
+  for (unsigned int i = latency; i < actual.size(); i++) {
+    BOOST_TEST(abs(actual[i] - expected[i - latency]) < tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(direct_form_test) {
+  streamingTest(2, FIRProcessor::defaultPartitionSize);
+  streamingTest(31, FIRProcessor::defaultPartitionSize);
+  streamingTest(FIRProcessor::maxDirectFormCoefficients,
+                FIRProcessor::defaultPartitionSize);
+}
+
+BOOST_AUTO_TEST_CASE(partitioned_test) {
+  streamingTest(FIRProcessor::maxDirectFormCoefficients + 1, 64);
+  streamingTest(501, FIRProcessor::defaultPartitionSize);
+  streamingTest(1001, 128);
+}
+
+BOOST_AUTO_TEST_CASE(reset_test) {
+  FIRProcessor processor({0.5, 0.5});
+  processor.process({1, 1, 1});
+  processor.reset();
+
+  auto result = processor.process({1, 1});
+  BOOST_TEST(result[0] == 0.5);
+  BOOST_TEST(result[1] == 1);
+
+  BOOST_REQUIRE_THROW(FIRProcessor({}), invalid_argument);
+  BOOST_REQUIRE_THROW(FIRProcessor({1}, 0), invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
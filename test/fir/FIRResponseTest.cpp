@@ -0,0 +1,96 @@
+#include "../../shared/fir/FIRResponse.hpp"
+#include "../../shared/fir/BlackmanWindow.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(FIRResponse_test)
+
+void transferFunctionTest(int samplingRate, int coefficientsCount,
+                          double step) {
+  FIRFilter filter = FIRFilter(FilterPass::lowPass, samplingRate / 8,
+                               coefficientsCount, BlackmanWindow(),
+                               samplingRate);
+  auto coefficients = filter.getFilterCoefficients();
+
+  // uniform grid matching DFT bins is evaluated with FFT
+  const int pointsCount = samplingRate / 2 / step;
+  auto uniformGrid = FrequencyGrid::linear(0, (pointsCount - 1) * step,
+                                           pointsCount);
+  auto fftValues = firTransferFunction(coefficients, samplingRate, uniformGrid);
+
+  // the same frequencies given as a list are evaluated directly
+  auto listGrid = FrequencyGrid::list(uniformGrid.getFrequencies());
+  auto directValues = firTransferFunction(coefficients, samplingRate, listGrid);
+
+  BOOST_TEST(fftValues.size() == pointsCount);
+  BOOST_TEST(directValues.size() == pointsCount);
+
+  const double tolerance = 1e-8;
+  for (int i = 0; i < pointsCount; i++) {
+    BOOST_TEST(abs(fftValues[i] - directValues[i]) < tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(transfer_function_test) {
+  transferFunctionTest(48000, 201, 1);
+  transferFunctionTest(48000, 201, 100);
+  transferFunctionTest(1000, 333, 1);
+  // less DFT points than coefficients
+  transferFunctionTest(1000, 333, 50);
+}
+
+BOOST_AUTO_TEST_CASE(fine_grid_test) {
+  FIRFilter filter =
+      FIRFilter(FilterPass::lowPass, 6000, 201, BlackmanWindow(), 48000);
+  auto coefficients = filter.getFilterCoefficients();
+
+  // bins of a DFT far too large to run, evaluated directly
+  auto uniformGrid = FrequencyGrid::linear(1000, 1000 + 9e-6, 10);
+  auto values = firTransferFunction(coefficients, 48000, uniformGrid);
+  auto directValues = firTransferFunction(
+      coefficients, 48000, FrequencyGrid::list(uniformGrid.getFrequencies()));
+
+  BOOST_TEST(values.size() == 10);
+  for (int i = 0; i < 10; i++) {
+    BOOST_TEST(abs(values[i] - directValues[i]) < 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(grid_response_test) {
+  const int samplingRate = 48000;
+  const int cutoffFrequency = 2000;
+  FIRFilter filter = FIRFilter(FilterPass::lowPass, cutoffFrequency, 301,
+                               BlackmanWindow(), samplingRate);
+
+  auto fullResponse = filter.calculateResponse();
+  BOOST_TEST(fullResponse.size() == samplingRate / 2);
+
+  // sub-Hz resolution on a log scale
+  auto grid = FrequencyGrid::logarithmic(0.5, samplingRate / 2 - 1, 500);
+  auto response = filter.calculateResponse(grid);
+  BOOST_TEST(response.size() == grid.size());
+
+  for (int i = 0; i < grid.size(); i++) {
+    const double frequency = grid.getFrequencies()[i];
+    BOOST_TEST(response[i].magnitudeDB <= 0);
+    if (frequency < cutoffFrequency / 2) {
+      BOOST_TEST(response[i].magnitudeDB > -1);
+    } else if (frequency > cutoffFrequency * 2) {
+      BOOST_TEST(response[i].magnitudeDB < -40);
+    }
+  }
+
+  // levels don't depend on the grid, stop band alone isn't at 0 dB
+  auto stopBandResponse =
+      filter.calculateResponse(FrequencyGrid::linear(5000, 5999, 1000));
+  for (int i = 0; i < 1000; i++) {
+    BOOST_TEST(abs(stopBandResponse[i].magnitudeDB -
+                   fullResponse[5000 + i].magnitudeDB) < 1e-4);
+    BOOST_TEST(stopBandResponse[i].magnitudeDB < -40);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
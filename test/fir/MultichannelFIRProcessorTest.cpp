@@ -0,0 +1,135 @@
+#include "../../shared/fir/MultichannelFIRProcessor.hpp"
+#include "../../shared/fir/BlackmanWindow.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/FIRProcessor.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(MultichannelFIRProcessor_test)
+
+vector<vector<double>> generateChannels(int channels, int frames) {
+  vector<vector<double>> samples(channels);
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < frames; i++) {
+      samples[ch].push_back(sin(i * 0.01 * (ch + 1)) + 0.2 * sin(i * 1.7) +
+                            ch * 0.1);
+    }
+  }
+  return samples;
+}
+
+void layoutTest(int coefficientsCount, int channels, ChannelLayout layout) {
+  FIRFilter filter = FIRFilter(FilterPass::lowPass, 1000, coefficientsCount,
+                               BlackmanWindow(), 48000);
+  const int frames = 1500;
+  auto samples = generateChannels(channels, frames);
+
+  // every channel filtered on its own
+  vector<vector<double>> expected;
+  for (int ch = 0; ch < channels; ch++) {
+    FIRProcessor processor(filter.getFilterCoefficients());
+    expected.push_back(processor.process(samples[ch]));
+  }
+
+  vector<double> buffer(channels * frames);
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < frames; i++) {
+      const int index = layout == ChannelLayout::interleaved
+                            ? i * channels + ch
+                            : ch * frames + i;
+      buffer[index] = samples[ch][i];
+    }
+  }
+
+  // filter in place, block by block
+  MultichannelFIRProcessor processor(filter, channels);
+  BOOST_TEST(processor.getChannelsCount() == channels);
+  BOOST_TEST(processor.getLatency() ==
+             FIRProcessor(filter.getFilterCoefficients()).getLatency());
+
+  vector<double> actual;
+  int blockSize = 1;
+  for (int from = 0; from < frames; from += blockSize) {
+    blockSize = min(blockSize % 200 + 29, frames - from);
+    vector<double> block(channels * blockSize);
+    for (int ch = 0; ch < channels; ch++) {
+      for (int i = 0; i < blockSize; i++) {
+        const int blockIndex = layout == ChannelLayout::interleaved
+                                   ? i * channels + ch
+                                   : ch * blockSize + i;
+        const int bufferIndex = layout == ChannelLayout::interleaved
+                                    ? (from + i) * channels + ch
+                                    : ch * frames + from + i;
+        block[blockIndex] = buffer[bufferIndex];
+      }
+    }
+    processor.process(block.data(), block.data(), blockSize, layout);
+    for (int ch = 0; ch < channels; ch++) {
+      for (int i = 0; i < blockSize; i++) {
+        const int blockIndex = layout == ChannelLayout::interleaved
+                                   ? i * channels + ch
+                                   : ch * blockSize + i;
+        const int bufferIndex = layout == ChannelLayout::interleaved
+                                    ? (from + i) * channels + ch
+                                    : ch * frames + from + i;
+        buffer[bufferIndex] = block[blockIndex];
+      }
+    }
+  }
+
+  const double tolerance = 1e-9;
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < frames; i++) {
+      const int index = layout == ChannelLayout::interleaved
+                            ? i * channels + ch
+                            : ch * frames + i;
+      BOOST_TEST(abs(buffer[index] - expected[ch][i]) < tolerance);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(layout_test) {
+  for (auto layout : {ChannelLayout::planar, ChannelLayout::interleaved}) {
+    for (int channels : {1, 5, 8, 37}) {
+      layoutTest(31, channels, layout);
+      layoutTest(FIRProcessor::maxDirectFormCoefficients, channels, layout);
+      layoutTest(301, channels, layout);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(vector_test) {
+  const int channels = 3;
+  FIRFilter filter = FIRFilter(FilterPass::highPass, 2000, 51,
+                               BlackmanWindow(), 48000);
+  auto samples = generateChannels(channels, 700);
+
+  MultichannelFIRProcessor processor(filter, channels);
+  auto actual = processor.process(samples);
+  BOOST_TEST(actual.size() == static_cast<size_t>(channels));
+
+  for (int ch = 0; ch < channels; ch++) {
+    FIRProcessor channelProcessor(filter.getFilterCoefficients());
+    auto expected = channelProcessor.process(samples[ch]);
+    for (unsigned int i = 0; i < expected.size(); i++) {
+      BOOST_TEST(abs(actual[ch][i] - expected[i]) < 1e-9);
+    }
+  }
+
+  // restarted stream gives the same result
+  processor.reset();
+  auto restarted = processor.process(samples);
+  for (int ch = 0; ch < channels; ch++) {
+    for (unsigned int i = 0; i < restarted[ch].size(); i++) {
+      BOOST_TEST(restarted[ch][i] == actual[ch][i]);
+    }
+  }
+
+  BOOST_CHECK_THROW(processor.process(vector<vector<double>>(2)),
+                    invalid_argument);
+  BOOST_CHECK_THROW(MultichannelFIRProcessor(filter, 0), invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#include "../../shared/fir/MultistageDecimator.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(MultistageDecimator_test)
+
+vector<double> sineSignal(double frequency, int samplingRate, int count) {
+  vector<double> samples;
+  for (int i = 0; i < count; i++) {
+    samples.push_back(sin(2 * numbers::pi * frequency * i / samplingRate));
+  }
+  return samples;
+}
+
+BOOST_AUTO_TEST_CASE(cascade_test) {
+  // same as running the stage decimators one after another
+  DecimationPlan plan(48000, {4, 3}, 1000, 60);
+  MultistageDecimator decimator(plan);
+  BOOST_TEST(decimator.getFactor() == 12);
+  BOOST_TEST(decimator.getStagesCount() == 2);
+
+  vector<double> expected = sineSignal(300, 48000, 20000);
+  const KaiserWindow window(60);
+  for (const auto &stage : plan.getStages()) {
+    PolyphaseDecimator stageDecimator(
+        FIRFilter(FilterPass::lowPass, stage.cutoffFrequency,
+                  stage.coefficientsCount, window, stage.inputSamplingRate),
+        stage.factor);
+    expected = stageDecimator.process(expected);
+  }
+
+  BOOST_TEST(decimator.process(sineSignal(300, 48000, 20000)) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  const auto plan = DecimationPlan::createOptimal(96000, 1000, 300, 70);
+  const auto samples = sineSignal(120, 96000, 50000);
+
+  MultistageDecimator wholeDecimator(plan);
+  auto expected = wholeDecimator.process(samples);
+  BOOST_TEST(expected.size() == 50000 / 96 + 1);
+
+  MultistageDecimator blockDecimator(plan);
+  vector<double> actual;
+  int blockSize = 1;
+  for (int i = 0; i < static_cast<int>(samples.size()); i += blockSize) {
+    blockSize = blockSize * 3 % 9001 + 5;
+    const int count = min(blockSize, static_cast<int>(samples.size()) - i);
+    vector<double> output(blockDecimator.getOutputCount(count));
+    BOOST_TEST(blockDecimator.process(&samples[i], output.data(), count) ==
+               static_cast<int>(output.size()));
+    actual.insert(actual.end(), output.begin(), output.end());
+  }
+  BOOST_TEST(actual == expected);
+
+  blockDecimator.reset();
+  BOOST_TEST(blockDecimator.process(samples) == expected);
+
+  // in place
+  blockDecimator.reset();
+  auto inPlace = samples;
+  inPlace.resize(blockDecimator.process(inPlace.data(), inPlace.data(),
+                                        inPlace.size()));
+  BOOST_TEST(inPlace == expected);
+}
+
+BOOST_AUTO_TEST_CASE(aliasing_test) {
+  const auto plan = DecimationPlan::createOptimal(192000, 1000, 400, 80);
+  const int count = 192000;
+
+  // pass band tone passes through, delayed by the cascade
+  MultistageDecimator passDecimator(plan);
+  auto output = passDecimator.process(sineSignal(100, 192000, count));
+  for (unsigned int n = output.size() / 2; n < output.size(); n++) {
+    const double expected =
+        sin(2 * numbers::pi * 100 * (n / 1000.0 - plan.getLatency()));
+    BOOST_TEST(abs(output[n] - expected) < 1e-3);
+  }
+
+  // tones that would alias into the pass band are attenuated
+  for (double frequency : {1100.0, 5900.0, 47800.0}) {
+    MultistageDecimator stopDecimator(plan);
+    output = stopDecimator.process(sineSignal(frequency, 192000, count));
+    for (unsigned int n = output.size() / 2; n < output.size(); n++) {
+      BOOST_TEST(abs(output[n]) < 1e-3);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+#include "../../shared/fir/PolyphaseDecimator.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(PolyphaseDecimator_test)
+
+/**
+ * Full rate convolution, then every factor-th sample
+ */
+vector<double> referenceDecimation(const vector<double> &coefficients,
+                                   const vector<double> &samples, int factor) {
+  vector<double> output;
+  for (unsigned int n = 0; n < samples.size(); n += factor) {
+    double sum = 0;
+    for (unsigned int k = 0; k < coefficients.size() && k <= n; k++) {
+      sum += coefficients[k] * samples[n - k];
+    }
+    output.push_back(sum);
+  }
+  return output;
+}
+
+vector<double> testSignal(int count) {
+  vector<double> samples;
+  for (int i = 0; i < count; i++) {
+    samples.push_back(sin(i * 0.01) + 0.3 * sin(i * 1.7 + 0.5));
+  }
+  return samples;
+}
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+  BOOST_REQUIRE_THROW(PolyphaseDecimator(vector<double>(), 2),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(PolyphaseDecimator(vector<double>{1, 2}, 0),
+                      invalid_argument);
+
+  PolyphaseDecimator decimator(vector<double>{1, 2, 3}, 4);
+  BOOST_TEST(decimator.getFactor() == 4);
+  BOOST_TEST(decimator.getOutputCount(0) == 0);
+  BOOST_TEST(decimator.getOutputCount(1) == 1);
+  BOOST_TEST(decimator.getOutputCount(4) == 1);
+  BOOST_TEST(decimator.getOutputCount(5) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(reference_test) {
+  const auto samples = testSignal(2000);
+  for (int factor : {1, 2, 3, 8}) {
+    for (const auto &coefficients :
+         {vector<double>{0.5}, vector<double>{0.1, 0.2, 0.4, 0.2, 0.1},
+          vector<double>{0.3, -0.1, 0.7, 0.2}}) {
+      PolyphaseDecimator decimator(coefficients, factor);
+      auto expected = referenceDecimation(coefficients, samples, factor);
+      auto actual = decimator.process(samples);
+      BOOST_TEST_REQUIRE(actual.size() == expected.size());
+      for (unsigned int i = 0; i < expected.size(); i++) {
+        BOOST_TEST(abs(actual[i] - expected[i]) < 1e-12);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  KaiserWindow window(80);
+  const auto filter =
+      FIRFilter::createAntiAliasingFilter(5, 48000, window, 500);
+  const auto samples = testSignal(5000);
+
+  PolyphaseDecimator wholeDecimator(filter, 5);
+  auto expected = wholeDecimator.process(samples);
+
+  // the same stream decimated in place in blocks not aligned to the factor
+  PolyphaseDecimator blockDecimator(filter, 5);
+  vector<double> buffer(samples);
+  vector<double> actual;
+  int blockSize = 1;
+  for (int i = 0; i < static_cast<int>(buffer.size()); i += blockSize) {
+    blockSize = blockSize % 97 + 7;
+    const int count = min(blockSize, static_cast<int>(buffer.size()) - i);
+    const int expectedCount = blockDecimator.getOutputCount(count);
+    const int outputCount =
+        blockDecimator.process(&buffer[i], &buffer[i], count);
+    BOOST_TEST(outputCount == expectedCount);
+    actual.insert(actual.end(), buffer.begin() + i,
+                  buffer.begin() + i + outputCount);
+  }
+
+  BOOST_TEST_REQUIRE(actual.size() == expected.size());
+  for (unsigned int i = 0; i < expected.size(); i++) {
+    BOOST_TEST(actual[i] == expected[i]);
+  }
+
+  blockDecimator.reset();
+  BOOST_TEST(blockDecimator.process(samples) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(anti_aliasing_test) {
+  const int samplingRate = 48000;
+  const int factor = 4;
+  KaiserWindow window(60);
+  const auto filter =
+      FIRFilter::createAntiAliasingFilter(factor, samplingRate, window, 600);
+  BOOST_TEST(filter.getCutoffFrequency() == 5400);
+
+  // tone above the output Nyquist frequency is not aliased,
+  // tone in the pass band is kept
+  auto amplitude = [&](double frequency) {
+    vector<double> samples;
+    for (int i = 0; i < 20000; i++) {
+      samples.push_back(sin(2 * numbers::pi * frequency * i / samplingRate));
+    }
+    PolyphaseDecimator decimator(filter, factor);
+    auto output = decimator.process(samples);
+    double maxValue = 0;
+    for (unsigned int i = output.size() / 2; i < output.size(); i++) {
+      maxValue = max(maxValue, abs(output[i]));
+    }
+    return maxValue;
+  };
+
+  BOOST_TEST(abs(amplitude(1000) - 1) < 0.01);
+  BOOST_TEST(amplitude(7000) < 1e-3);
+  BOOST_TEST(amplitude(15000) < 1e-3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#include "../../shared/fir/PolyphaseInterpolator.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(PolyphaseInterpolator_test)
+
+/**
+ * Zeros inserted between samples, then full rate convolution
+ */
+vector<double> referenceInterpolation(const vector<double> &coefficients,
+                                      const vector<double> &samples,
+                                      int factor) {
+  vector<double> upsampled(samples.size() * factor, 0);
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    upsampled[i * factor] = factor * samples[i];
+  }
+  vector<double> output;
+  for (unsigned int n = 0; n < upsampled.size(); n++) {
+    double sum = 0;
+    for (unsigned int k = 0; k < coefficients.size() && k <= n; k++) {
+      sum += coefficients[k] * upsampled[n - k];
+    }
+    output.push_back(sum);
+  }
+  return output;
+}
+
+vector<double> testSignal(int count) {
+  vector<double> samples;
+  for (int i = 0; i < count; i++) {
+    samples.push_back(sin(i * 0.05) + 0.3 * sin(i * 1.7 + 0.5));
+  }
+  return samples;
+}
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+  BOOST_REQUIRE_THROW(PolyphaseInterpolator(vector<double>(), 2),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(PolyphaseInterpolator(vector<double>{1, 2}, 0),
+                      invalid_argument);
+
+  PolyphaseInterpolator interpolator(vector<double>(10, 1), 3);
+  BOOST_TEST(interpolator.getFactor() == 3);
+  BOOST_TEST(interpolator.getBranchSize() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(reference_test) {
+  const auto samples = testSignal(500);
+  for (int factor : {1, 2, 3, 8}) {
+    for (const auto &coefficients :
+         {vector<double>{0.5}, vector<double>{0.1, 0.2, 0.4, 0.2, 0.1},
+          vector<double>{0.3, -0.1, 0.7, 0.2, 0.05, 0.01, -0.2}}) {
+      PolyphaseInterpolator interpolator(coefficients, factor);
+      auto expected = referenceInterpolation(coefficients, samples, factor);
+      auto actual = interpolator.process(samples);
+      BOOST_TEST_REQUIRE(actual.size() == expected.size());
+      for (unsigned int i = 0; i < expected.size(); i++) {
+        BOOST_TEST(abs(actual[i] - expected[i]) < 1e-12);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  KaiserWindow window(80);
+  const auto filter =
+      FIRFilter::createAntiAliasingFilter(3, 48000, window, 500);
+  const auto samples = testSignal(3000);
+
+  PolyphaseInterpolator wholeInterpolator(filter, 3);
+  auto expected = wholeInterpolator.process(samples);
+
+  PolyphaseInterpolator blockInterpolator(filter, 3);
+  vector<double> actual(samples.size() * 3);
+  int blockSize = 1;
+  for (int i = 0; i < static_cast<int>(samples.size()); i += blockSize) {
+    blockSize = blockSize % 97 + 7;
+    blockInterpolator.process(
+        &samples[i], &actual[i * 3],
+        min(blockSize, static_cast<int>(samples.size()) - i));
+  }
+
+  for (unsigned int i = 0; i < expected.size(); i++) {
+    BOOST_TEST(actual[i] == expected[i]);
+  }
+
+  blockInterpolator.reset();
+  BOOST_TEST(blockInterpolator.process(samples) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(anti_imaging_test) {
+  // 8 kHz tone at 16 kHz upsampled to 48 kHz has no images at 8 +- 16 kHz
+  const int factor = 3;
+  const int outputSamplingRate = 48000;
+  KaiserWindow window(60);
+  const auto filter = FIRFilter::createAntiAliasingFilter(
+      factor, outputSamplingRate, window, 500);
+
+  vector<double> samples;
+  for (int i = 0; i < 8000; i++) {
+    samples.push_back(sin(2 * numbers::pi * 1000 * i / 16000));
+  }
+  PolyphaseInterpolator interpolator(filter, factor);
+  auto output = interpolator.process(samples);
+
+  // output is the same 1 kHz tone at the output rate, delayed by the filter
+  const double delay = (filter.getFilterCoefficients().size() - 1) / 2.0;
+  for (unsigned int n = output.size() / 2; n < output.size(); n++) {
+    const double expected =
+        sin(2 * numbers::pi * 1000 * (n - delay) / outputSamplingRate);
+    BOOST_TEST(abs(output[n] - expected) < 2e-3);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+#include "../../shared/fir/PolyphaseResampler.hpp"
+#include "../../shared/Sampling.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include "../../shared/fir/PolyphaseInterpolator.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(PolyphaseResampler_test)
+
+vector<double> testSignal(int count) {
+  vector<double> samples;
+  for (int i = 0; i < count; i++) {
+    samples.push_back(sin(i * 0.05) + 0.3 * sin(i * 1.7 + 0.5));
+  }
+  return samples;
+}
+
+vector<double> sineSignal(int frequency, int samplingRate, int count) {
+  vector<double> samples;
+  for (int i = 0; i < count; i++) {
+    samples.push_back(sin(2 * numbers::pi * frequency * i / samplingRate));
+  }
+  return samples;
+}
+
+/**
+ * Check the second half of the output is the same tone at the output rate,
+ * delayed by the prototype filter
+ */
+void sineTest(PolyphaseResampler &resampler, int inputSamplingRate,
+              double tolerance) {
+  const int frequency = 1000;
+  const double outputSamplingRate = inputSamplingRate * resampler.getRatio();
+  auto output =
+      resampler.process(sineSignal(frequency, inputSamplingRate, 8000));
+
+  for (unsigned int n = output.size() / 2; n < output.size(); n++) {
+    const double time =
+        n / outputSamplingRate - resampler.getDelay() / inputSamplingRate;
+    const double expected = sin(2 * numbers::pi * frequency * time);
+    BOOST_TEST(abs(output[n] - expected) < tolerance);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+  KaiserWindow window(60);
+  BOOST_REQUIRE_THROW(PolyphaseResampler(0, 48000, window, 500),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(PolyphaseResampler(48000, 0, window, 500),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(PolyphaseResampler(48000, 0.0, window, 500),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(PolyphaseResampler(48000, 1.5, window, 500, 0),
+                      invalid_argument);
+  // transition band wider than the lower rate pass band
+  BOOST_REQUIRE_THROW(PolyphaseResampler(48000, 16000, window, 8000),
+                      invalid_argument);
+
+  PolyphaseResampler rational(44100, 48000, window, 1000);
+  BOOST_TEST(rational.isRational());
+  BOOST_TEST(rational.getInterpolationFactor() == 160);
+  BOOST_TEST(rational.getDecimationFactor() == 147);
+  BOOST_TEST(rational.getPhasesCount() == 160);
+  BOOST_TEST(abs(rational.getRatio() - 48000.0 / 44100) < 1e-15);
+
+  // reduced L is too large for a phase table
+  PolyphaseResampler coprime(44100, 44101, window, 1000);
+  BOOST_TEST(!coprime.isRational());
+  BOOST_TEST(coprime.getPhasesCount() ==
+             PolyphaseResampler::defaultPhasesCount);
+}
+
+BOOST_AUTO_TEST_CASE(reference_test) {
+  // upsampling by L and keeping every M-th sample
+  KaiserWindow window(60);
+  const auto samples = testSignal(600);
+  for (auto [inputSamplingRate, outputSamplingRate] :
+       {pair{3000, 2000}, pair{2000, 3000}, pair{4000, 1000},
+        pair{1000, 1000}}) {
+    PolyphaseResampler resampler(inputSamplingRate, outputSamplingRate,
+                                 window, 100);
+    const int factor = resampler.getInterpolationFactor();
+
+    const int prototypeSamplingRate = factor * inputSamplingRate;
+    const FIRFilter prototype(
+        FilterPass::lowPass,
+        min(inputSamplingRate, outputSamplingRate) / 2 - 100,
+        FIRFilter::getOptimalCoefficientsCount(prototypeSamplingRate, window,
+                                               100),
+        window, prototypeSamplingRate);
+    PolyphaseInterpolator interpolator(
+        normalizeGain(prototype.getFilterCoefficients()), factor);
+    const auto upsampled = interpolator.process(samples);
+
+    const auto actual = resampler.process(samples);
+    BOOST_TEST_REQUIRE(static_cast<int>(actual.size()) ==
+                       static_cast<int>(upsampled.size() +
+                                        resampler.getDecimationFactor() - 1) /
+                           resampler.getDecimationFactor());
+    for (unsigned int i = 0; i < actual.size(); i++) {
+      BOOST_TEST(abs(actual[i] -
+                     upsampled[i * resampler.getDecimationFactor()]) < 1e-12);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  KaiserWindow window(80);
+  const auto samples = testSignal(3000);
+
+  for (bool rational : {true, false}) {
+    auto createResampler = [&]() {
+      return rational ? PolyphaseResampler(44100, 48000, window, 2000)
+                      : PolyphaseResampler(44100, 1.0884, window, 2000);
+    };
+    auto wholeResampler = createResampler();
+    auto expected = wholeResampler.process(samples);
+
+    auto blockResampler = createResampler();
+    vector<double> actual;
+    int blockSize = 1;
+    for (int i = 0; i < static_cast<int>(samples.size()); i += blockSize) {
+      blockSize = blockSize % 97 + 7;
+      const int count = min(blockSize, static_cast<int>(samples.size()) - i);
+      vector<double> output(blockResampler.getMaxOutputCount(count));
+      output.resize(blockResampler.process(&samples[i], output.data(), count));
+      actual.insert(actual.end(), output.begin(), output.end());
+    }
+    BOOST_TEST(actual == expected);
+    BOOST_TEST(abs(static_cast<int>(expected.size()) -
+                   samples.size() * wholeResampler.getRatio()) <= 1);
+
+    blockResampler.reset();
+    BOOST_TEST(blockResampler.process(samples) == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rational_sine_test) {
+  KaiserWindow window(80);
+  PolyphaseResampler upsampler(44100, 48000, window, 2000);
+  sineTest(upsampler, 44100, 1e-3);
+
+  PolyphaseResampler downsampler(48000, 44100, window, 2000);
+  sineTest(downsampler, 48000, 1e-3);
+
+  PolyphaseResampler decimator(48000, 16000, window, 1000);
+  BOOST_TEST(decimator.getInterpolationFactor() == 1);
+  sineTest(decimator, 48000, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(fractional_sine_test) {
+  KaiserWindow window(80);
+  PolyphaseResampler upsampler(44100, numbers::sqrt2, window, 2000);
+  BOOST_TEST(!upsampler.isRational());
+  sineTest(upsampler, 44100, 1e-3);
+
+  PolyphaseResampler downsampler(48000, 1 / numbers::pi, window, 2000);
+  sineTest(downsampler, 48000, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(branch_size_test) {
+  // per output cost depends on the transition band, not on L/M,
+  // up to the rounding of the prototype length
+  KaiserWindow window(80);
+  PolyphaseResampler simple(48000, 24000, window, 1000);
+  PolyphaseResampler complex(48000, 44100, window, 1000);
+  BOOST_TEST(abs(simple.getBranchSize() - complex.getBranchSize()) <= 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
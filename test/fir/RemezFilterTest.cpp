@@ -0,0 +1,167 @@
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include "../../shared/fir/RemezFilter.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(RemezFilter_test)
+
+/**
+ * Check pass band ripple and stop band attenuation of the designed filter
+ *
+ * @return max stop band magnitude (dB)
+ */
+double bandsTest(const RemezFilter &filter, int transitionLength,
+                 double attenuationDB, double passBandRippleDB) {
+  const int samplingRate = filter.getSamplingRate();
+  const int cutoffFrequency = filter.getCutoffFrequency();
+  auto response = filter.calculateFrequencyResponse(
+      FrequencyGrid::linear(0, samplingRate / 2 - 1, samplingRate / 2));
+
+  double maxStopBandDB = -INFINITY;
+  for (int i = 0; i < response.size(); i++) {
+    const double frequency = response.getFrequencies()[i];
+    const double magnitudeDB = response.getMagnitudesDB()[i];
+    const bool lowPass = filter.getPassType() == FilterPass::lowPass;
+    const bool passBand =
+        lowPass ? frequency <= cutoffFrequency - transitionLength
+                : frequency >= cutoffFrequency + transitionLength;
+    const bool stopBand =
+        lowPass ? frequency >= cutoffFrequency + transitionLength
+                : frequency <= cutoffFrequency - transitionLength;
+    if (passBand) {
+      // magnitudes are relative to the peak, which is the top of the ripple,
+      // estimated number of coefficients may miss the target by a bit
+      BOOST_TEST(magnitudeDB > -passBandRippleDB * 1.2);
+    }
+    if (stopBand) {
+      maxStopBandDB = max(maxStopBandDB, magnitudeDB);
+    }
+  }
+
+  BOOST_TEST(maxStopBandDB < -attenuationDB + 1);
+  return maxStopBandDB;
+}
+
+BOOST_AUTO_TEST_CASE(low_pass_test) {
+  const int samplingRate = 48000;
+  const int transitionLength = 500;
+  const double attenuationDB = 60;
+  const int coefficientsCount = RemezFilter::getOptimalCoefficientsCount(
+      samplingRate, attenuationDB, transitionLength);
+  BOOST_TEST(coefficientsCount % 2 == 1);
+
+  RemezFilter filter(FilterPass::lowPass, 6000, transitionLength,
+                     attenuationDB, coefficientsCount, samplingRate);
+  BOOST_TEST(filter.getFilterCoefficients().size() == coefficientsCount);
+  BOOST_TEST(filter.getIterationsCount() > 0);
+
+  // linear phase
+  auto coefficients = filter.getFilterCoefficients();
+  for (int i = 0; i < coefficientsCount; i++) {
+    BOOST_TEST(abs(coefficients[i] - coefficients[coefficientsCount - 1 - i]) <
+               1e-12);
+  }
+
+  // equiripple: the stop band peak is close to the target,
+  // not way below it as with windows
+  const double maxStopBandDB =
+      bandsTest(filter, transitionLength, attenuationDB,
+                RemezFilter::defaultPassBandRippleDB);
+  BOOST_TEST(maxStopBandDB > -attenuationDB - 3);
+}
+
+BOOST_AUTO_TEST_CASE(high_pass_test) {
+  const int samplingRate = 44100;
+  const int transitionLength = 200;
+  const double attenuationDB = 50;
+  const double passBandRippleDB = 0.5;
+  const int coefficientsCount = RemezFilter::getOptimalCoefficientsCount(
+      samplingRate, attenuationDB, transitionLength, passBandRippleDB);
+
+  RemezFilter filter(FilterPass::highPass, 2000, transitionLength,
+                     attenuationDB, coefficientsCount, samplingRate,
+                     passBandRippleDB);
+  bandsTest(filter, transitionLength, attenuationDB, passBandRippleDB);
+}
+
+BOOST_AUTO_TEST_CASE(even_coefficients_count_test) {
+  const int samplingRate = 48000;
+  const int transitionLength = 1000;
+  const double attenuationDB = 40;
+  const int coefficientsCount =
+      RemezFilter::getOptimalCoefficientsCount(samplingRate, attenuationDB,
+                                               transitionLength) +
+      1;
+
+  RemezFilter filter(FilterPass::lowPass, 10000, transitionLength,
+                     attenuationDB, coefficientsCount, samplingRate);
+  BOOST_TEST(filter.getFilterCoefficients().size() == coefficientsCount);
+  bandsTest(filter, transitionLength, attenuationDB,
+            RemezFilter::defaultPassBandRippleDB);
+}
+
+BOOST_AUTO_TEST_CASE(cancellation_test) {
+  const int samplingRate = 48000;
+  const int transitionLength = 100;
+  const double attenuationDB = 60;
+  const int coefficientsCount = RemezFilter::getOptimalCoefficientsCount(
+      samplingRate, attenuationDB, transitionLength);
+
+  int checksCount = 0;
+  RemezFilter cancelled(FilterPass::lowPass, 6000, transitionLength,
+                        attenuationDB, coefficientsCount, samplingRate,
+                        RemezFilter::defaultPassBandRippleDB, [&] {
+                          checksCount++;
+                          return true;
+                        });
+  BOOST_TEST(cancelled.getIterationsCount() == 1);
+  BOOST_TEST(checksCount == 1);
+  BOOST_TEST(cancelled.getFilterCoefficients().size() == coefficientsCount);
+
+  RemezFilter completed(FilterPass::lowPass, 6000, transitionLength,
+                        attenuationDB, coefficientsCount, samplingRate,
+                        RemezFilter::defaultPassBandRippleDB,
+                        [] { return false; });
+  BOOST_TEST(completed.getIterationsCount() > 1);
+}
+
+BOOST_AUTO_TEST_CASE(optimal_coefficients_count_test) {
+  // equiripple design needs fewer coefficients than the Kaiser window
+  for (double attenuationDB : {40, 60, 80}) {
+    const int remezCount =
+        RemezFilter::getOptimalCoefficientsCount(48000, attenuationDB, 300);
+    const int kaiserCount = FIRFilter::getOptimalCoefficientsCount(
+        48000, KaiserWindow(attenuationDB), 300);
+    BOOST_TEST(remezCount < kaiserCount);
+    BOOST_TEST(RemezFilter::getTransitionLength(48000, attenuationDB,
+                                                remezCount) <= 300);
+  }
+
+  BOOST_REQUIRE_THROW(RemezFilter::getOptimalCoefficientsCount(48000, 60, 0),
+                      invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_parameters_test) {
+  // transition band outside of (0, samplingRate/2)
+  BOOST_REQUIRE_THROW(
+      RemezFilter(FilterPass::lowPass, 100, 100, 60, 101, 48000),
+      invalid_argument);
+  BOOST_REQUIRE_THROW(
+      RemezFilter(FilterPass::lowPass, 23900, 100, 60, 101, 48000),
+      invalid_argument);
+  BOOST_REQUIRE_THROW(RemezFilter(FilterPass::lowPass, 1000, 0, 60, 101, 48000),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(RemezFilter(FilterPass::lowPass, 1000, 100, 60, 2, 48000),
+                      invalid_argument);
+  // type II filters are 0 at samplingRate/2
+  BOOST_REQUIRE_THROW(
+      RemezFilter(FilterPass::highPass, 1000, 100, 60, 100, 48000),
+      invalid_argument);
+  BOOST_REQUIRE_THROW(RemezFilter(FilterPass::lowPass, 1000, 100, 0, 101, 48000),
+                      invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
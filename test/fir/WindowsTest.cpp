@@ -0,0 +1,170 @@
+#include "../../shared/fir/BlackmanWindow.hpp"
+#include "../../shared/fir/ChebyshevWindow.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/HammingWindow.hpp"
+#include "../../shared/fir/HannWindow.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include "../../shared/fir/NuttallWindow.hpp"
+#include "../../shared/fir/RectangularWindow.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(Windows_test)
+
+vector<unique_ptr<Window>> allWindows() {
+  vector<unique_ptr<Window>> windows;
+  windows.emplace_back(new RectangularWindow());
+  windows.emplace_back(new HannWindow());
+  windows.emplace_back(new HammingWindow());
+  windows.emplace_back(new BlackmanWindow());
+  windows.emplace_back(new NuttallWindow());
+  windows.emplace_back(new KaiserWindow(40));
+  windows.emplace_back(new KaiserWindow(80));
+  windows.emplace_back(new ChebyshevWindow(40));
+  windows.emplace_back(new ChebyshevWindow(80));
+  return windows;
+}
+
+BOOST_AUTO_TEST_CASE(coefficients_test) {
+  for (const auto &window : allWindows()) {
+    for (int windowSize : {1, 2, 10, 51}) {
+      auto coefficients = window->getCoefficients(windowSize);
+      BOOST_TEST_REQUIRE(coefficients.size() == windowSize);
+
+      // symmetric, peak is 1 in the middle
+      for (int i = 0; i < windowSize; i++) {
+        BOOST_TEST(abs(coefficients[i] - coefficients[windowSize - 1 - i]) <
+                   1e-9);
+        BOOST_TEST(coefficients[i] <= 1 + 1e-9);
+        BOOST_TEST(coefficients[i] > -1e-9);
+      }
+      if (windowSize % 2 == 1) {
+        BOOST_TEST(abs(coefficients[windowSize / 2] - 1) < 1e-9);
+      }
+    }
+    BOOST_REQUIRE_THROW(window->getCoefficients(0), invalid_argument);
+  }
+
+  BOOST_REQUIRE_THROW(KaiserWindow(0), invalid_argument);
+  BOOST_REQUIRE_THROW(ChebyshevWindow(-1), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(kaiser_beta_test) {
+  BOOST_TEST(KaiserWindow::getBeta(20) == 0);
+  BOOST_TEST(abs(KaiserWindow::getBeta(60) - 5.65326) < 1e-5);
+  BOOST_TEST(KaiserWindow(40).getBeta() < KaiserWindow(80).getBeta());
+  // windows with different shapes don't share cached tables,
+  // even if the shapes differ by less than a printable digit
+  KaiserWindow window(60);
+  KaiserWindow closeWindow(60 + 1e-7);
+  BOOST_TEST((window.getCacheKey() != closeWindow.getCacheKey()));
+  BOOST_TEST(window.getCachedCoefficients(101) !=
+             closeWindow.getCachedCoefficients(101));
+  BOOST_TEST(*closeWindow.getCachedCoefficients(101) ==
+             closeWindow.getCoefficients(101));
+  BOOST_TEST(KaiserWindow(60).getCachedCoefficients(101) ==
+             window.getCachedCoefficients(101));
+}
+
+/**
+ * Window which doesn't opt in to the coefficients cache
+ */
+class TriangularWindow : public Window {
+public:
+  vector<double> getCoefficients(int windowSize) const override {
+    vector<double> coefficients;
+    for (int i = 0; i < windowSize; i++) {
+      coefficients.push_back(1 - abs(2.0 * i / (windowSize - 1) - 1));
+    }
+    return coefficients;
+  }
+  double getTransitionWidthFactor() const override { return 4; }
+  double getAttenuationDB() const override { return 25; }
+};
+
+BOOST_AUTO_TEST_CASE(uncached_window_test) {
+  TriangularWindow window;
+  BOOST_TEST(!window.getCacheKey());
+  auto coefficients = window.getCachedCoefficients(11);
+  BOOST_TEST(*coefficients == window.getCoefficients(11));
+  BOOST_TEST(window.getCachedCoefficients(11) != coefficients);
+}
+
+BOOST_AUTO_TEST_CASE(chebyshev_side_lobes_test) {
+  // Dolph-Chebyshev window has equal side lobes at the given level
+  const int windowSize = 63;
+  const double attenuationDB = 50;
+  auto coefficients = ChebyshevWindow(attenuationDB).getCoefficients(windowSize);
+
+  const int pointsCount = 4096;
+  vector<double> spectrum;
+  for (int k = 0; k < pointsCount / 2; k++) {
+    complex<double> sum = 0;
+    for (int i = 0; i < windowSize; i++) {
+      sum += coefficients[i] * polar(1.0, -2 * numbers::pi * k * i / pointsCount);
+    }
+    spectrum.push_back(abs(sum));
+  }
+
+  // past the main lobe
+  int firstNull = 1;
+  while (spectrum[firstNull + 1] < spectrum[firstNull]) {
+    firstNull++;
+  }
+  double maxSideLobe = 0;
+  for (unsigned int k = firstNull; k < spectrum.size(); k++) {
+    maxSideLobe = max(maxSideLobe, spectrum[k]);
+  }
+  const double sideLobeDB = 20 * log10(maxSideLobe / spectrum[0]);
+  BOOST_TEST(abs(sideLobeDB + attenuationDB) < 0.1);
+}
+
+void stopBandTest(const Window &window, int samplingRate, int cutoffFrequency,
+                  int transitionLength) {
+  const int coefficientsCount = FIRFilter::getOptimalCoefficientsCount(
+      samplingRate, window, transitionLength);
+  BOOST_TEST(coefficientsCount % 2 == 1);
+  BOOST_TEST(FIRFilter::getTransitionLength(samplingRate, window,
+                                            coefficientsCount) <=
+             transitionLength);
+
+  FIRFilter filter(FilterPass::lowPass, cutoffFrequency, coefficientsCount,
+                   window, samplingRate);
+  // magnitudes are relative to the peak within the grid,
+  // so the grid starts in the pass band
+  const int stopBandFrom = cutoffFrequency + transitionLength;
+  auto response = filter.calculateFrequencyResponse(
+      FrequencyGrid::linear(0, samplingRate / 2 - 1, samplingRate / 2));
+  for (int i = 0; i < response.size(); i++) {
+    if (response.getFrequencies()[i] >= stopBandFrom) {
+      // window parameters are empirical, allow 2 dB
+      BOOST_TEST(response.getMagnitudesDB()[i] <
+                 -window.getAttenuationDB() + 2);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(optimal_coefficients_count_test) {
+  for (const auto &window : allWindows()) {
+    stopBandTest(*window, 48000, 5000, 500);
+    stopBandTest(*window, 44100, 1000, 100);
+  }
+
+  // Kaiser window reaches Blackman's attenuation with fewer coefficients
+  const int blackmanCount =
+      FIRFilter::getOptimalCoefficientsCount(48000, BlackmanWindow(), 200);
+  const int kaiserCount = FIRFilter::getOptimalCoefficientsCount(
+      48000, KaiserWindow(BlackmanWindow().getAttenuationDB()), 200);
+  BOOST_TEST(kaiserCount < blackmanCount);
+
+  BOOST_REQUIRE_THROW(
+      FIRFilter::getOptimalCoefficientsCount(48000, HannWindow(), 0),
+      invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,51 @@
+#include "../../shared/iir/IIRProcessor.hpp"
+#include "../../shared/iir/HighPassCRCircuit.hpp"
+#include "../../shared/iir/LowPassRCCircuit.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(IIRProcessor_test)
+
+void streamingTest(const IIRFilter &filter) {
+  vector<double> samples;
+  for (int i = 0; i < 3000; i++) {
+    samples.push_back(sin(i * 0.03) + 0.2 * sin(i * 2.1));
+  }
+
+  // whole buffer filtered at once
+  IIRProcessor wholeProcessor(filter);
+  auto expected = wholeProcessor.process(samples);
+
+  // the same stream filtered in place block by block
+  IIRProcessor blockProcessor(filter);
+  vector<double> actual(samples);
+  int blockSize = 1;
+  for (int i = 0; i < static_cast<int>(actual.size()); i += blockSize) {
+    blockSize = blockSize % 200 + 13;
+    blockProcessor.process(actual.data() + i,
+                           min(blockSize, static_cast<int>(actual.size()) - i));
+  }
+
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    BOOST_TEST(actual[i] == expected[i]);
+  }
+
+  // IIRFilter::apply starts history from the first sample
+  auto applied = filter.apply(samples);
+  IIRProcessor continuedProcessor(filter);
+  continuedProcessor.reset(samples[0], samples[0]);
+  auto continued = continuedProcessor.process(
+      vector<double>(samples.begin() + 1, samples.end()));
+  for (unsigned int i = 1; i < samples.size(); i++) {
+    BOOST_TEST(applied[i] == continued[i - 1]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  streamingTest(LowPassRCCircuit(1000, 48000));
+  streamingTest(HighPassCRCircuit(1000, 48000));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,8 @@
 #include "../../shared/iir/LowPassRCCircuit.hpp"
+#include "../../shared/Sampling.hpp"
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <numbers>
 
 using namespace std;
 
@@ -58,4 +61,30 @@ BOOST_AUTO_TEST_CASE(response_test) {
   testFrequencyResponse(20000, 100000);
 }
 
+void testSteadyStateResponse(int frequency, int cutoffFrequency,
+                             int samplingRate) {
+  LowPassRCCircuit circuit = LowPassRCCircuit(cutoffFrequency, samplingRate);
+  auto response =
+      circuit.calculateResponse(FrequencyGrid::list({(double)frequency}));
+
+  // simulate long enough sine wave to let the transient settle
+  vector<double> samples;
+  for (int i = 0; i < samplingRate; i++) {
+    samples.push_back(sin(2 * numbers::pi * frequency * i / samplingRate));
+  }
+  auto filtered = circuit.apply(samples);
+  vector<double> lastPeriod(filtered.end() - samplingRate / frequency,
+                            filtered.end());
+
+  const double tolerance = 0.05;
+  BOOST_TEST(abs(response[0].magnitudeDB - toDB(maxAbsValue(lastPeriod))) <
+             tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(steady_state_response_test) {
+  testSteadyStateResponse(100, 1000, 48000);
+  testSteadyStateResponse(1000, 1000, 48000);
+  testSteadyStateResponse(400, 1000, 48000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+#include "../../shared/iir/MultichannelIIRProcessor.hpp"
+#include "../../shared/iir/HighPassCRCircuit.hpp"
+#include "../../shared/iir/IIRProcessor.hpp"
+#include "../../shared/iir/LowPassRCCircuit.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(MultichannelIIRProcessor_test)
+
+void layoutTest(const IIRFilter &filter, int channels, ChannelLayout layout) {
+  const int frames = 2000;
+  vector<vector<double>> expected;
+  vector<double> buffer(channels * frames);
+  for (int ch = 0; ch < channels; ch++) {
+    vector<double> samples;
+    for (int i = 0; i < frames; i++) {
+      samples.push_back(sin(i * 0.02 * (ch + 1)) + 0.1 * sin(i * 2.3));
+      const int index = layout == ChannelLayout::interleaved
+                            ? i * channels + ch
+                            : ch * frames + i;
+      buffer[index] = samples[i];
+    }
+    IIRProcessor processor(filter);
+    expected.push_back(processor.process(samples));
+  }
+
+  MultichannelIIRProcessor processor(filter, channels);
+  BOOST_TEST(processor.getChannelsCount() == channels);
+  vector<double> output(buffer.size());
+  processor.process(buffer.data(), output.data(), frames, layout);
+
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < frames; i++) {
+      const int index = layout == ChannelLayout::interleaved
+                            ? i * channels + ch
+                            : ch * frames + i;
+      BOOST_TEST(abs(output[index] - expected[ch][i]) < 1e-12);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(layout_test) {
+  for (auto layout : {ChannelLayout::planar, ChannelLayout::interleaved}) {
+    for (int channels : {1, 2, 7, 64}) {
+      layoutTest(LowPassRCCircuit(1000, 48000), channels, layout);
+      layoutTest(HighPassCRCircuit(1000, 48000), channels, layout);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  const int channels = 4;
+  LowPassRCCircuit filter(500, 48000);
+  vector<vector<double>> samples(channels);
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < 1000; i++) {
+      samples[ch].push_back(cos(i * 0.05 + ch));
+    }
+  }
+
+  MultichannelIIRProcessor wholeProcessor(filter, channels);
+  auto expected = wholeProcessor.process(samples);
+
+  // the same channels filtered in two halves
+  MultichannelIIRProcessor blockProcessor(filter, channels);
+  vector<vector<double>> first(channels), second(channels);
+  for (int ch = 0; ch < channels; ch++) {
+    first[ch].assign(samples[ch].begin(), samples[ch].begin() + 300);
+    second[ch].assign(samples[ch].begin() + 300, samples[ch].end());
+  }
+  auto firstFiltered = blockProcessor.process(first);
+  auto secondFiltered = blockProcessor.process(second);
+
+  for (int ch = 0; ch < channels; ch++) {
+    for (int i = 0; i < 300; i++) {
+      BOOST_TEST(firstFiltered[ch][i] == expected[ch][i]);
+    }
+    for (int i = 300; i < 1000; i++) {
+      BOOST_TEST(secondFiltered[ch][i - 300] == expected[ch][i]);
+    }
+  }
+
+  BOOST_CHECK_THROW(blockProcessor.process(vector<vector<double>>(1)),
+                    invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+#include "../../shared/iir/SOSFilter.hpp"
+#include "../../shared/fir/FIRFilter.hpp"
+#include "../../shared/fir/KaiserWindow.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(SOSFilter_test)
+
+double magnitudeDB(const SOSFilter &filter, double frequency) {
+  return filter
+      .calculateFrequencyResponse(FrequencyGrid::linear(frequency, frequency, 1))
+      .getMagnitudesDB()[0];
+}
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+  BOOST_REQUIRE_THROW(SOSFilter(IIRApproximation::butterworth,
+                                FilterPass::lowPass, 0, 1000, 60, 48000),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(SOSFilter(IIRApproximation::butterworth,
+                                FilterPass::lowPass, 4, 24000, 60, 48000),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(SOSFilter(IIRApproximation::chebyshev,
+                                FilterPass::lowPass, 4, 1000, 60, 48000, 0),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(SOSFilter(IIRApproximation::elliptic,
+                                FilterPass::lowPass, 4, 1000, 0.05, 48000),
+                      invalid_argument);
+
+  for (int order : {1, 2, 5, 8}) {
+    SOSFilter filter(IIRApproximation::elliptic, FilterPass::lowPass, order,
+                     1000, 60, 48000);
+    BOOST_TEST(filter.getOrder() == order);
+    BOOST_TEST(filter.getSections().size() == (order + 1) / 2);
+    BOOST_TEST(filter.getFilterCoefficients().size() ==
+               5 * filter.getSections().size());
+
+    // stable, all poles inside the unit circle
+    for (const auto &section : filter.getSections()) {
+      BOOST_TEST(abs(section.a2) < 1);
+      BOOST_TEST(abs(section.a1) < 1 + section.a2);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(butterworth_test) {
+  for (int order : {1, 2, 3, 6}) {
+    SOSFilter lowPass(IIRApproximation::butterworth, FilterPass::lowPass,
+                      order, 2000, 0, 48000);
+    BOOST_TEST(abs(magnitudeDB(lowPass, 0)) < 1e-9);
+    BOOST_TEST(abs(magnitudeDB(lowPass, 2000) + 3.0103) < 1e-3);
+
+    SOSFilter highPass(IIRApproximation::butterworth, FilterPass::highPass,
+                       order, 2000, 0, 48000);
+    BOOST_TEST(abs(magnitudeDB(highPass, 24000)) < 1e-9);
+    BOOST_TEST(abs(magnitudeDB(highPass, 2000) + 3.0103) < 1e-3);
+  }
+
+  // -6 dB per octave per order far from the cutoff
+  SOSFilter filter(IIRApproximation::butterworth, FilterPass::lowPass, 4, 100,
+                   0, 48000);
+  BOOST_TEST(abs(magnitudeDB(filter, 3200) - magnitudeDB(filter, 1600) + 24) <
+             0.5);
+}
+
+void passBandTest(const SOSFilter &filter, double passBandRippleDB) {
+  const int cutoffFrequency = filter.getCutoffFrequency();
+  const bool lowPass = filter.getPassType() == FilterPass::lowPass;
+  const int from = lowPass ? 0 : cutoffFrequency;
+  const int to = lowPass ? cutoffFrequency : filter.getSamplingRate() / 2;
+
+  auto response = filter.calculateFrequencyResponse(
+      FrequencyGrid::linear(from, to, to - from + 1));
+  double minDB = INFINITY;
+  double maxDB = -INFINITY;
+  for (double magnitude : response.getMagnitudesDB()) {
+    minDB = min(minDB, magnitude);
+    maxDB = max(maxDB, magnitude);
+  }
+  BOOST_TEST(maxDB < 1e-9);
+  BOOST_TEST(minDB > -passBandRippleDB - 1e-6);
+  // equiripple, the whole ripple is used
+  BOOST_TEST(minDB < -passBandRippleDB + 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(chebyshev_test) {
+  for (int order : {3, 4}) {
+    for (auto passType : {FilterPass::lowPass, FilterPass::highPass}) {
+      passBandTest(SOSFilter(IIRApproximation::chebyshev, passType, order,
+                             3000, 0, 48000, 0.5),
+                   0.5);
+    }
+  }
+}
+
+void ellipticTest(FilterPass passType, int cutoffFrequency,
+                  int transitionLength, double attenuationDB,
+                  int samplingRate) {
+  const int order = SOSFilter::getOptimalOrder(
+      IIRApproximation::elliptic, passType, cutoffFrequency, transitionLength,
+      attenuationDB, samplingRate);
+  SOSFilter filter(IIRApproximation::elliptic, passType, order,
+                   cutoffFrequency, attenuationDB, samplingRate);
+  passBandTest(filter, SOSFilter::defaultPassBandRippleDB);
+
+  const int stopBandFrequency = passType == FilterPass::lowPass
+                                    ? cutoffFrequency + 2 * transitionLength
+                                    : cutoffFrequency - 2 * transitionLength;
+  const int from = passType == FilterPass::lowPass ? stopBandFrequency : 0;
+  const int to = passType == FilterPass::lowPass ? samplingRate / 2
+                                                 : stopBandFrequency;
+  auto response = filter.calculateFrequencyResponse(
+      FrequencyGrid::linear(from, to, to - from + 1));
+  for (double magnitude : response.getMagnitudesDB()) {
+    BOOST_TEST(magnitude < -attenuationDB + 1e-6);
+  }
+
+  // one order less doesn't reach the attenuation
+  if (order > 1) {
+    SOSFilter shorter(IIRApproximation::elliptic, passType, order - 1,
+                      cutoffFrequency, attenuationDB, samplingRate);
+    BOOST_TEST(magnitudeDB(shorter, stopBandFrequency) > -attenuationDB);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_test) {
+  ellipticTest(FilterPass::lowPass, 5000, 250, 60, 48000);
+  ellipticTest(FilterPass::lowPass, 1000, 50, 80, 44100);
+  ellipticTest(FilterPass::highPass, 2000, 200, 50, 48000);
+  ellipticTest(FilterPass::highPass, 10000, 500, 70, 96000);
+}
+
+BOOST_AUTO_TEST_CASE(optimal_order_test) {
+  auto order = [](IIRApproximation approximation) {
+    return SOSFilter::getOptimalOrder(approximation, FilterPass::lowPass, 5000,
+                                      250, 60, 48000);
+  };
+  BOOST_TEST(order(IIRApproximation::elliptic) <
+             order(IIRApproximation::chebyshev));
+  BOOST_TEST(order(IIRApproximation::chebyshev) <
+             order(IIRApproximation::butterworth));
+
+  // elliptic filter meets the spec of a few hundred taps FIR filter
+  BOOST_TEST(order(IIRApproximation::elliptic) <= 10);
+  BOOST_TEST(FIRFilter::getOptimalCoefficientsCount(48000, KaiserWindow(60),
+                                                    250) > 300);
+
+  BOOST_REQUIRE_THROW(SOSFilter::getOptimalOrder(IIRApproximation::elliptic,
+                                                 FilterPass::lowPass, 23000,
+                                                 1000, 60, 48000),
+                      invalid_argument);
+  BOOST_REQUIRE_THROW(SOSFilter::getOptimalOrder(IIRApproximation::elliptic,
+                                                 FilterPass::highPass, 1000,
+                                                 500, 60, 48000),
+                      invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+#include "../../shared/iir/SOSProcessor.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+#include <numbers>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(SOSProcessor_test)
+
+BOOST_AUTO_TEST_CASE(streaming_test) {
+  SOSFilter filter(IIRApproximation::elliptic, FilterPass::lowPass, 7, 3000,
+                   70, 48000);
+  vector<double> samples;
+  for (int i = 0; i < 3000; i++) {
+    samples.push_back(sin(i * 0.03) + 0.2 * sin(i * 2.1));
+  }
+
+  // whole buffer filtered at once
+  SOSProcessor wholeProcessor(filter);
+  BOOST_TEST(wholeProcessor.getSectionsCount() == 4);
+  auto expected = wholeProcessor.process(samples);
+
+  // the same stream filtered in place block by block
+  SOSProcessor blockProcessor(filter);
+  vector<double> actual(samples);
+  int blockSize = 1;
+  for (int i = 0; i < static_cast<int>(actual.size()); i += blockSize) {
+    blockSize = blockSize % 300 + 13;
+    blockProcessor.process(actual.data() + i,
+                           min(blockSize, static_cast<int>(actual.size()) - i));
+  }
+
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    BOOST_TEST(actual[i] == expected[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(impulse_response_test) {
+  // DFT of the impulse response matches the transfer function
+  for (auto passType : {FilterPass::lowPass, FilterPass::highPass}) {
+    SOSFilter filter(IIRApproximation::chebyshev, passType, 6, 4000, 0, 48000,
+                     1);
+    SOSProcessor processor(filter);
+    vector<double> impulse(4096, 0);
+    impulse[0] = 1;
+    auto impulseResponse = processor.process(impulse);
+
+    auto response = filter.calculateFrequencyResponse(
+        FrequencyGrid::linear(0, 24000, 25));
+    for (int i = 0; i < response.size(); i++) {
+      complex<double> sum = 0;
+      for (unsigned int n = 0; n < impulseResponse.size(); n++) {
+        sum += impulseResponse[n] *
+               polar(1.0, -2 * numbers::pi * response.getFrequencies()[i] * n /
+                              48000);
+      }
+      BOOST_TEST(abs(abs(sum) - pow(10, response.getMagnitudesDB()[i] / 20)) <
+                 1e-9);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(reset_test) {
+  SOSFilter filter(IIRApproximation::butterworth, FilterPass::lowPass, 5, 1000,
+                   0, 48000);
+  SOSProcessor processor(filter);
+
+  // settled on a constant input, low pass filter passes it as is
+  processor.reset(0.7);
+  auto output = processor.process(vector<double>(100, 0.7));
+  for (double sample : output) {
+    BOOST_TEST(abs(sample - 0.7) < 1e-12);
+  }
+
+  // SOSFilter::apply starts from the steady state of the first sample
+  vector<double> samples(200, -0.3);
+  samples[150] = 1;
+  auto applied = filter.apply(samples);
+  BOOST_TEST(abs(applied[0] + 0.3) < 1e-12);
+  BOOST_TEST(abs(applied[149] + 0.3) < 1e-12);
+
+  processor.reset();
+  output = processor.process(vector<double>(10, 0));
+  for (double sample : output) {
+    BOOST_TEST(sample == 0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()